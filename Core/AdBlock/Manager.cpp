@@ -37,6 +37,7 @@
 #include "Application.hpp"
 
 #include "Network/NetworkManager.hpp"
+#include "Network/RequestContext.hpp"
 
 #include "AdBlock/Rule.hpp"
 #include "AdBlock/Matcher.hpp"
@@ -325,22 +326,18 @@ bool Manager::removeSubscription(Subscription* subscription)
 	return true;
 }
 
-bool Manager::block(QWebEngineUrlRequestInfo& request)
+bool Manager::block(const RequestContext& context, QWebEngineUrlRequestInfo& request)
 {
-	const QString urlString{request.requestUrl().toEncoded().toLower()};
-	const QString urlDomain{request.requestUrl().host().toLower()};
-	const QString urlScheme{request.requestUrl().scheme().toLower()};
-
-	if (!isEnabled() || !canRunOnScheme(urlScheme))
+	if (!isEnabled() || !canRunOnScheme(context.scheme()))
 		return false;
 
 	bool res{false};
-	const Rule* blockedRule{m_matcher->match(request, urlDomain, urlString)};
+	const Rule* blockedRule{m_matcher->match(context)};
 
 	if (blockedRule) {
 		res = true;
 
-		if (request.resourceType() == QWebEngineUrlRequestInfo::ResourceTypeMainFrame) {
+		if (context.resourceType() == QWebEngineUrlRequestInfo::ResourceTypeMainFrame) {
 			QUrl url{QStringLiteral("sielo:adblock")};
 			QUrlQuery query{};
 
@@ -35,6 +35,8 @@
 #include <QWebEngineUrlRequestInfo>
 
 namespace Sn {
+class RequestContext;
+
 namespace ADB {
 class Rule;
 
@@ -75,7 +77,7 @@ public:
 	Subscription* addSubscription(const QString& title, const QString& url);
 	bool removeSubscription(Subscription* subscription);
 
-	bool block(QWebEngineUrlRequestInfo& request);
+	bool block(const RequestContext& context, QWebEngineUrlRequestInfo& request);
 
 	QStringList disabledRules() const { return m_disabledRules; }
 
@@ -29,6 +29,8 @@
 #include "AdBlock/Subscription.hpp"
 #include "AdBlock/Rule.hpp"
 
+#include "Network/RequestContext.hpp"
+
 namespace Sn {
 namespace ADB {
 
@@ -44,22 +46,21 @@ Matcher::~Matcher()
 	clear();
 }
 
-const Rule* Matcher::match(const QWebEngineUrlRequestInfo& request, const QString& urlDomain,
-						   const QString& urlString) const
+const Rule* Matcher::match(const RequestContext& context) const
 {
-	if (m_networkExceptionTree.find(request, urlDomain, urlString))
+	if (m_networkExceptionTree.find(context))
 		return nullptr;
 
 			foreach (const Rule* rule, m_networkExceptionRules) {
-			if (rule->networkMatch(request, urlDomain, urlString))
+			if (rule->networkMatch(context))
 				return nullptr;
 		}
 
-	if (const Rule* rule = m_networkBlockTree.find(request, urlDomain, urlString))
+	if (const Rule* rule = m_networkBlockTree.find(context))
 		return rule;
 
 			foreach (const Rule* rule, m_networkBlockRules) {
-			if (rule->networkMatch(request, urlDomain, urlString))
+			if (rule->networkMatch(context))
 				return rule;
 		}
 
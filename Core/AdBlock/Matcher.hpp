@@ -32,11 +32,11 @@
 
 #include <QUrl>
 
-#include <QWebEngineUrlRequestInfo>
-
 #include "AdBlock/SearchTree.hpp"
 
 namespace Sn {
+class RequestContext;
+
 namespace ADB {
 class Manager;
 
@@ -49,8 +49,7 @@ public:
 	Matcher(Manager* manager);
 	~Matcher();
 
-	const Rule* match(const QWebEngineUrlRequestInfo& request, const QString& urlDomain,
-					  const QString& urlString) const;
+	const Rule* match(const RequestContext& context) const;
 
 	bool adBlockDisabledForUrl(const QUrl& url) const;
 	bool elementHideDisabledForUrl(const QUrl& url) const;
@@ -29,28 +29,11 @@
 #include "AdBlock/SearchTree.hpp"
 #include "AdBlock/Subscription.hpp"
 
+#include "Network/RequestContext.hpp"
+
 namespace Sn {
 namespace ADB {
 
-static QString toSecondLevelDomain(const QUrl& url)
-{
-	const QString topLevelDomain{url.topLevelDomain()};
-	const QString urlHost{url.host()};
-
-	if (topLevelDomain.isEmpty() || url.host().isEmpty())
-		return QString();
-
-	QString domain{urlHost.left(urlHost.size() - topLevelDomain.size())};
-
-	if (domain.count(QLatin1Char('.')) != 0)
-		return urlHost;
-
-	while (domain.count(QLatin1Char('.')) != 0)
-		domain = domain.mid(domain.indexOf(QLatin1Char('.')) + 1);
-
-	return domain + topLevelDomain;
-}
-
 Rule::Rule(const QString& filter, Subscription* subscription) :
 		m_subscription(subscription),
 		m_type(StringContainsMatchRule),
@@ -170,36 +153,35 @@ bool Rule::urlMatch(const QUrl& url) const
 	return stringMatch(domain, encodedUrl);
 }
 
-bool Rule::networkMatch(const QWebEngineUrlRequestInfo& request, const QString& domain,
-						const QString& encodedUrl) const
+bool Rule::networkMatch(const RequestContext& context) const
 {
 	if (m_type == CSSRule || !m_isEnabled || m_isInternalDisabled)
 		return false;
 
-	bool matched{stringMatch(domain, encodedUrl)};
+	bool matched{stringMatch(context.host(), context.encodedUrl())};
 
 	if (matched) {
-		if (hasOption(DomainRestrictedOption) && !matchDomain(request.firstPartyUrl().host()))
+		if (hasOption(DomainRestrictedOption) && !matchDomain(context.firstPartyHost()))
 			return false;
-		if (hasOption(ThirdPartyOption) && !matchThirdParty(request))
+		if (hasOption(ThirdPartyOption) && !matchThirdParty(context))
 			return false;
-		if (hasOption(ObjectOption) && !matchObject(request))
+		if (hasOption(ObjectOption) && !matchObject(context))
 			return false;
-		if (hasOption(SubdocumentOption) && !matchSubdocument(request))
+		if (hasOption(SubdocumentOption) && !matchSubdocument(context))
 			return false;
-		if (hasOption(XMLHttpRequestOption) && !matchXMLHttpRequest(request))
+		if (hasOption(XMLHttpRequestOption) && !matchXMLHttpRequest(context))
 			return false;
-		if (hasOption(ImageOption) && !matchImage(request))
+		if (hasOption(ImageOption) && !matchImage(context))
 			return false;
-		if (hasOption(ScriptOption) && !matchScript(request))
+		if (hasOption(ScriptOption) && !matchScript(context))
 			return false;
-		if (hasOption(StyleSheetOption) && !matchStyleSheet(request))
+		if (hasOption(StyleSheetOption) && !matchStyleSheet(context))
 			return false;
-		if (hasOption(ObjectSubrequestOption) && !matchObjectSubrequest(request))
+		if (hasOption(ObjectSubrequestOption) && !matchObjectSubrequest(context))
 			return false;
-		if (hasOption(PingOption) && !matchPing(request))
+		if (hasOption(PingOption) && !matchPing(context))
 			return false;
-		if (hasOption(MediaOption) && !matchMedia(request))
+		if (hasOption(MediaOption) && !matchMedia(context))
 			return false;
 
 	}
@@ -249,90 +231,87 @@ bool Rule::matchDomain(const QString& domain) const
 	return false;
 }
 
-bool Rule::matchThirdParty(const QWebEngineUrlRequestInfo& request) const
+bool Rule::matchThirdParty(const RequestContext& context) const
 {
-	const QString firstPartyHost{toSecondLevelDomain(request.firstPartyUrl())};
-	const QString host{toSecondLevelDomain(request.requestUrl())};
-
-	bool match{firstPartyHost != host};
+	bool match{context.isThirdParty()};
 
 	return hasException(ThirdPartyOption) == !match;
 }
 
-bool Rule::matchObject(const QWebEngineUrlRequestInfo& request) const
+bool Rule::matchObject(const RequestContext& context) const
 {
-	bool match{request.resourceType() == QWebEngineUrlRequestInfo::ResourceTypeObject};
+	bool match{context.resourceType() == QWebEngineUrlRequestInfo::ResourceTypeObject};
 
 	return hasException(ObjectOption) == !match;
 }
 
-bool Rule::matchSubdocument(const QWebEngineUrlRequestInfo& request) const
+bool Rule::matchSubdocument(const RequestContext& context) const
 {
-	bool match{request.resourceType() == QWebEngineUrlRequestInfo::ResourceTypeSubFrame};
+	bool match{context.resourceType() == QWebEngineUrlRequestInfo::ResourceTypeSubFrame};
 
 	return hasException(SubdocumentOption) == !match;
 }
 
-bool Rule::matchXMLHttpRequest(const QWebEngineUrlRequestInfo& request) const
+bool Rule::matchXMLHttpRequest(const RequestContext& context) const
 {
-	bool match{request.resourceType() == QWebEngineUrlRequestInfo::ResourceTypeXhr};
+	bool match{context.resourceType() == QWebEngineUrlRequestInfo::ResourceTypeXhr};
 
 	return hasException(XMLHttpRequestOption) == !match;
 }
 
-bool Rule::matchImage(const QWebEngineUrlRequestInfo& request) const
+bool Rule::matchImage(const RequestContext& context) const
 {
-	bool match{request.resourceType() == QWebEngineUrlRequestInfo::ResourceTypeImage};
+	bool match{context.resourceType() == QWebEngineUrlRequestInfo::ResourceTypeImage};
 
 	return hasException(ImageOption) == !match;
 }
 
-bool Rule::matchScript(const QWebEngineUrlRequestInfo& request) const
+bool Rule::matchScript(const RequestContext& context) const
 {
-	bool match{request.resourceType() == QWebEngineUrlRequestInfo::ResourceTypeScript};
+	bool match{context.resourceType() == QWebEngineUrlRequestInfo::ResourceTypeScript};
 
 	return hasException(ScriptOption) == !match;
 }
 
-bool Rule::matchStyleSheet(const QWebEngineUrlRequestInfo& request) const
+bool Rule::matchStyleSheet(const RequestContext& context) const
 {
-	bool match{request.resourceType() == QWebEngineUrlRequestInfo::ResourceTypeStylesheet};
+	bool match{context.resourceType() == QWebEngineUrlRequestInfo::ResourceTypeStylesheet};
 
 	return hasException(StyleSheetOption) == !match;
 }
 
-bool Rule::matchObjectSubrequest(const QWebEngineUrlRequestInfo& request) const
+bool Rule::matchObjectSubrequest(const RequestContext& context) const
 {
-	bool match{request.resourceType() == QWebEngineUrlRequestInfo::ResourceTypePluginResource};
+	bool match{context.resourceType() == QWebEngineUrlRequestInfo::ResourceTypePluginResource};
 
 	return hasException(ObjectSubrequestOption) == !match;
 }
 
-bool Rule::matchPing(const QWebEngineUrlRequestInfo& request) const
+bool Rule::matchPing(const RequestContext& context) const
 {
-	bool match{request.resourceType() == QWebEngineUrlRequestInfo::ResourceTypePing};
+	bool match{context.resourceType() == QWebEngineUrlRequestInfo::ResourceTypePing};
 
 	return hasException(PingOption) == !match;
 }
 
-bool Rule::matchMedia(const QWebEngineUrlRequestInfo& request) const
+bool Rule::matchMedia(const RequestContext& context) const
 {
-	bool match{request.resourceType() == QWebEngineUrlRequestInfo::ResourceTypeMedia};
+	bool match{context.resourceType() == QWebEngineUrlRequestInfo::ResourceTypeMedia};
 
 	return hasException(MediaOption) == !match;
 }
 
-bool Rule::matchOther(const QWebEngineUrlRequestInfo& request) const
+bool Rule::matchOther(const RequestContext& context) const
 {
 	bool match{
-			request.resourceType() == QWebEngineUrlRequestInfo::ResourceTypeFontResource ||
-			request.resourceType() == QWebEngineUrlRequestInfo::ResourceTypeSubResource ||
-			request.resourceType() == QWebEngineUrlRequestInfo::ResourceTypeWorker ||
-			request.resourceType() == QWebEngineUrlRequestInfo::ResourceTypeSharedWorker ||
-			request.resourceType() == QWebEngineUrlRequestInfo::ResourceTypePrefetch ||
-			request.resourceType() == QWebEngineUrlRequestInfo::ResourceTypeFavicon ||
-			request.resourceType() == QWebEngineUrlRequestInfo::ResourceTypeServiceWorker ||
-			request.resourceType() == QWebEngineUrlRequestInfo::ResourceTypeUnknown
+			context.resourceType() == QWebEngineUrlRequestInfo::ResourceTypeFontResource ||
+			context.resourceType() == QWebEngineUrlRequestInfo::ResourceTypeSubResource ||
+			context.resourceType() == QWebEngineUrlRequestInfo::ResourceTypeWorker ||
+			context.resourceType() == QWebEngineUrlRequestInfo::ResourceTypeSharedWorker ||
+			context.resourceType() == QWebEngineUrlRequestInfo::ResourceTypePrefetch ||
+			context.resourceType() == QWebEngineUrlRequestInfo::ResourceTypeFavicon ||
+			context.resourceType() == QWebEngineUrlRequestInfo::ResourceTypeServiceWorker ||
+			context.resourceType() == QWebEngineUrlRequestInfo::ResourceTypeUnknown
 	};
 
 	return hasException(MediaOption) == !match;
@@ -35,11 +35,12 @@
 
 #include <QUrl>
 
-#include <QWebEngineUrlRequestInfo>
 
 #include "Utils/RegExp.hpp"
 
 namespace Sn {
+class RequestContext;
+
 namespace ADB {
 class Subscription;
 
@@ -81,20 +82,20 @@ public:
 	bool isInternalDisabled() const;
 
 	bool urlMatch(const QUrl& url) const;
-	bool networkMatch(const QWebEngineUrlRequestInfo& request, const QString& domain, const QString& encodedUrl) const;
+	bool networkMatch(const RequestContext& context) const;
 
 	bool matchDomain(const QString& domain) const;
-	bool matchThirdParty(const QWebEngineUrlRequestInfo& request) const;
-	bool matchObject(const QWebEngineUrlRequestInfo& request) const;
-	bool matchSubdocument(const QWebEngineUrlRequestInfo& request) const;
-	bool matchXMLHttpRequest(const QWebEngineUrlRequestInfo& request) const;
-	bool matchImage(const QWebEngineUrlRequestInfo& request) const;
-	bool matchScript(const QWebEngineUrlRequestInfo& request) const;
-	bool matchStyleSheet(const QWebEngineUrlRequestInfo& request) const;
-	bool matchObjectSubrequest(const QWebEngineUrlRequestInfo& request) const;
-	bool matchPing(const QWebEngineUrlRequestInfo& request) const;
-	bool matchMedia(const QWebEngineUrlRequestInfo& request) const;
-	bool matchOther(const QWebEngineUrlRequestInfo& request) const;
+	bool matchThirdParty(const RequestContext& context) const;
+	bool matchObject(const RequestContext& context) const;
+	bool matchSubdocument(const RequestContext& context) const;
+	bool matchXMLHttpRequest(const RequestContext& context) const;
+	bool matchImage(const RequestContext& context) const;
+	bool matchScript(const RequestContext& context) const;
+	bool matchStyleSheet(const RequestContext& context) const;
+	bool matchObjectSubrequest(const RequestContext& context) const;
+	bool matchPing(const RequestContext& context) const;
+	bool matchMedia(const RequestContext& context) const;
+	bool matchOther(const RequestContext& context) const;
 
 protected:
 	bool stringMatch(const QString& domain, const QString& encodedUrl) const;
@@ -28,6 +28,8 @@
 
 #include "AdBlock/Rule.hpp"
 
+#include "Network/RequestContext.hpp"
+
 namespace Sn {
 namespace ADB {
 
@@ -79,9 +81,9 @@ bool SearchTree::add(const Rule* rule)
 	return true;
 }
 
-const Rule* SearchTree::find(const QWebEngineUrlRequestInfo& request, const QString& domain,
-							 const QString& urlString) const
+const Rule* SearchTree::find(const RequestContext& context) const
 {
+	const QString& urlString{context.encodedUrl()};
 	int length{urlString.size()};
 
 	if (length <= 0)
@@ -90,7 +92,7 @@ const Rule* SearchTree::find(const QWebEngineUrlRequestInfo& request, const QStr
 	const QChar* string{urlString.constData()};
 
 	for (int i{0}; i < length; ++i) {
-		const Rule* rule{prefixSearch(request, domain, urlString, ++string, length - i)};
+		const Rule* rule{prefixSearch(context, ++string, length - i)};
 		if (rule)
 			return rule;
 	}
@@ -98,8 +100,7 @@ const Rule* SearchTree::find(const QWebEngineUrlRequestInfo& request, const QStr
 	return nullptr;
 }
 
-const Rule* SearchTree::prefixSearch(const QWebEngineUrlRequestInfo& request, const QString& domain,
-									 const QString& urlString, const QChar* string, int length) const
+const Rule* SearchTree::prefixSearch(const RequestContext& context, const QChar* string, int length) const
 {
 	if (length <= 0)
 		return nullptr;
@@ -114,7 +115,7 @@ const Rule* SearchTree::prefixSearch(const QWebEngineUrlRequestInfo& request, co
 	for (int i{1}; i < length; ++i) {
 		const QChar c{(++string)[0]};
 
-		if (node->rule && node->rule->networkMatch(request, domain, urlString))
+		if (node->rule && node->rule->networkMatch(context))
 			return node->rule;
 		if (!node->children.contains(c))
 			return nullptr;
@@ -122,7 +123,7 @@ const Rule* SearchTree::prefixSearch(const QWebEngineUrlRequestInfo& request, co
 		node = node->children[c];
 	}
 
-	if (node->rule && node->rule->networkMatch(request, domain, urlString))
+	if (node->rule && node->rule->networkMatch(context))
 		return node->rule;
 
 	return nullptr;
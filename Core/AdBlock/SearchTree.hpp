@@ -29,9 +29,9 @@
 #include <QChar>
 #include <QHash>
 
-#include <QWebEngineUrlRequestInfo>
-
 namespace Sn {
+class RequestContext;
+
 namespace ADB {
 class Rule;
 
@@ -43,7 +43,7 @@ public:
 	void clear();
 
 	bool add(const Rule* rule);
-	const Rule* find(const QWebEngineUrlRequestInfo& request, const QString& domain, const QString& urlString) const;
+	const Rule* find(const RequestContext& context) const;
 
 private:
 	struct Node {
@@ -56,8 +56,7 @@ private:
 				rule(nullptr) {}
 	};
 
-	const Rule* prefixSearch(const QWebEngineUrlRequestInfo& request, const QString& domain, const QString& urlString,
-							 const QChar* string, int length) const;
+	const Rule* prefixSearch(const RequestContext& context, const QChar* string, int length) const;
 
 	void deleteNode(Node* node);
 
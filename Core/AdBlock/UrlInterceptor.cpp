@@ -27,6 +27,12 @@
 
 #include "AdBlock/Manager.hpp"
 
+#include "Network/RequestContext.hpp"
+
+#include "Web/Tab/TabsMetrics.hpp"
+
+#include "Application.hpp"
+
 namespace Sn {
 namespace ADB {
 
@@ -34,13 +40,17 @@ UrlInterceptor::UrlInterceptor(Manager* manager) :
 	BaseUrlInterceptor(manager),
 	m_manager(manager)
 {
-	// Empty
+	setObjectName(QStringLiteral("AdBlock"));
 }
 
-void UrlInterceptor::interceptRequest(QWebEngineUrlRequestInfo& info)
+void UrlInterceptor::interceptRequest(const RequestContext& context, QWebEngineUrlRequestInfo& info)
 {
-	if (m_manager->block(info))
-		info.block(true);
+	if (m_manager->block(context, info)) {
+		blockRequest(info);
+
+		if (TabsMetrics* metrics = Application::instance()->tabsMetrics())
+			metrics->addBlockedRequest(context.firstPartyHost());
+	}
 }
 
 }
@@ -40,7 +40,7 @@ class UrlInterceptor: public BaseUrlInterceptor {
 public:
 	UrlInterceptor(Manager* manager);
 
-	void interceptRequest(QWebEngineUrlRequestInfo& info);
+	void interceptRequest(const RequestContext& context, QWebEngineUrlRequestInfo& info);
 
 private:
 	Manager* m_manager{nullptr};
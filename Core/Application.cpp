@@ -26,6 +26,14 @@
 
 #include <QStandardPaths>
 #include <QDir>
+#include <QSaveFile>
+#include <QRegularExpression>
+
+#include <QtConcurrent/QtConcurrentRun>
+
+#include <QReadWriteLock>
+#include <QAtomicInt>
+#include <QSharedPointer>
 
 #include <QStyle>
 
@@ -38,6 +46,7 @@
 #include <QFontDatabase>
 
 #include <QMessageBox>
+#include <QDebug>
 
 #include <QSettings>
 
@@ -66,11 +75,17 @@
 #include "Database/SqlDatabase.hpp"
 #include "Utils/CommandLineOption.hpp"
 #include "Utils/Updater.hpp"
+#include "Utils/SettingsCache.hpp"
+#include "Utils/StartupTracer.hpp"
+#include "Utils/StyleSheetCompiler.hpp"
+#include "Utils/ThemeArchive.hpp"
 
 #include "Web/WebPage.hpp"
 #include "Web/Scripts.hpp"
 #include "Web/HTML5Permissions/HTML5PermissionsManager.hpp"
 #include "Web/Tab/TabbedWebView.hpp"
+#include "Web/Tab/TabsLifecycleManager.hpp"
+#include "Web/Tab/TabsMetrics.hpp"
 
 #include "Network/NetworkManager.hpp"
 
@@ -83,6 +98,23 @@ namespace Sn
 {
 QString Application::currentVersion = QString("1.15.00 closed-beta");
 
+// Icons resolved by getAppIcon, dropped each time the icon theme change
+struct AppIconsCache {
+	QReadWriteLock lock{};
+	QHash<QString, QIcon> icons{};
+	int generation{0};
+
+	// Set when the active theme is read from a .snthm archive
+	QSharedPointer<ThemeArchive> archive{};
+	QString archiveIconsPrefix{};
+	QString archiveDirectory{};
+};
+
+Q_GLOBAL_STATIC(AppIconsCache, appIconsCache)
+static QAtomicInt s_themeGeneration{0};
+
+static const QString RESOURCES_THEMES_PATH = QStringLiteral(":data/themes");
+
 // Static member
 QList<QString> Application::paths()
 {
@@ -109,9 +141,58 @@ Application *Application::instance()
 
 QIcon Application::getAppIcon(const QString& name, const QString& directory, const QString& format)
 {
-	// Return icon from active theme folder (in %data%/themes/%ativetheme%/%logo-path%
-	// Else, it return the default icon from icon.qrc file
-	return QIcon::fromTheme(name, QIcon(":icons/" + directory + '/' + name + format));
+	// Looking for an icon in the theme means searching the theme directories, and this is called
+	// from models data() and completer jobs threads, so icons are cached until the theme change
+	const QString key{directory + QLatin1Char('/') + name + format};
+	const int generation{s_themeGeneration.loadAcquire()};
+
+	QSharedPointer<ThemeArchive> archive{};
+	QString archiveIconsPrefix{};
+	QString archiveDirectory{};
+
+	{
+		QReadLocker locker{&appIconsCache->lock};
+
+		if (appIconsCache->generation == generation) {
+			QHash<QString, QIcon>::const_iterator it{appIconsCache->icons.constFind(key)};
+
+			if (it != appIconsCache->icons.constEnd())
+				return it.value();
+		}
+
+		archive = appIconsCache->archive;
+		archiveIconsPrefix = appIconsCache->archiveIconsPrefix;
+		archiveDirectory = appIconsCache->archiveDirectory;
+	}
+
+	const QIcon defaultIcon{":icons/" + directory + '/' + name + format};
+	QIcon icon{};
+
+	if (archive) {
+		// Only the icons really used are extracted from the theme archive
+		const QString iconPath{archive->extract(archiveIconsPrefix + key, archiveDirectory)};
+		icon = iconPath.isEmpty() ? defaultIcon : QIcon(iconPath);
+	}
+	else {
+		// Return icon from active theme folder (in %data%/themes/%ativetheme%/%logo-path%
+		// Else, it return the default icon from icon.qrc file
+		icon = QIcon::fromTheme(name, defaultIcon);
+	}
+
+	QWriteLocker locker{&appIconsCache->lock};
+
+	// The theme changed while we were looking for the icon
+	if (appIconsCache->generation > generation)
+		return icon;
+
+	if (appIconsCache->generation != generation) {
+		appIconsCache->icons.clear();
+		appIconsCache->generation = generation;
+	}
+
+	appIconsCache->icons.insert(key, icon);
+
+	return icon;
 }
 
 QByteArray Application::readAllFileByteContents(const QString& filename)
@@ -192,8 +273,19 @@ Application::Application(int& argc, char** argv) :
 	m_morpheusFont = QFont(family);
 	m_normalFont = font();*/
 
+	StartupTracer::mark("applicationCreated");
+
+	m_sessionCheckpointTimer = new QTimer(this);
+	connect(m_sessionCheckpointTimer, &QTimer::timeout, this, &Application::checkpointSession);
+	connect(&m_sessionWriter, &QFutureWatcher<bool>::finished, this, &Application::sessionCheckpointWritten);
+
+	StartupTracer::begin("translateApplication");
 	translateApplication();
+	StartupTracer::end();
+
+	StartupTracer::begin("loadSettings");
 	loadSettings();
+	StartupTracer::end();
 
 	// Check command line options with given arguments
 	QUrl startUrl{};
@@ -202,6 +294,8 @@ Application::Application(int& argc, char** argv) :
 	bool newInstance{false};
 
 	// Check startup arguments
+	StartupTracer::begin("parseCommandLine");
+
 	if (argc > 1) {
 		CommandLineOption command{};
 
@@ -220,6 +314,9 @@ Application::Application(int& argc, char** argv) :
 			case Application::CL_StartNewInstance:
 				newInstance = true;
 				break;
+			case Application::CL_TraceStartup:
+				StartupTracer::setEnabled(true);
+				break;
 			case Application::CL_OpenUrlInCurrentTab:
 				startUrl = QUrl::fromUserInput(pair.text);
 				messages.append("ACTION:OpenUrlInCurrentTab" + pair.text);
@@ -241,6 +338,8 @@ Application::Application(int& argc, char** argv) :
 		}
 	}
 
+	StartupTracer::end();
+
 	if (messages.isEmpty()) {
 		messages.append(QLatin1String(" "));
 	}
@@ -260,16 +359,22 @@ Application::Application(int& argc, char** argv) :
 	QDesktopServices::setUrlHandler("https", this, "addNewTab");
 	QDesktopServices::setUrlHandler("ftp", this, "addNewTab");
 
+	StartupTracer::begin("connectDatabase");
 	connectDatabase(); // connect ndb
+	StartupTracer::end();
 
 	m_plugins = new PluginProxy;
 
 	// Setting up web and network objects
+	StartupTracer::begin("setupWebProfile");
+
 	m_webProfile = privateBrowsing() ? new QWebEngineProfile(this) : QWebEngineProfile::defaultProfile();
 	connect(m_webProfile, &QWebEngineProfile::downloadRequested, this, &Application::downloadRequested);
 
+	// AutoFill and AdBlock are initialized once the first window is shown (see initDeferredSubsystems)
 	m_networkManager = new NetworkManager(this);
-	m_autoFill = new AutoFill;
+	m_tabsLifecycleManager = new TabsLifecycleManager(this);
+	m_tabsMetrics = new TabsMetrics(this);
 
 	// Setup web channel with custom script (mainly for autofill)
 	QString webChannelScriptSrc = Scripts::webChannelDefautlScript();
@@ -284,6 +389,8 @@ Application::Application(int& argc, char** argv) :
 
 	m_webProfile->scripts()->insert(script);
 
+	StartupTracer::end();
+
 	// Check if we start after a crash
 	if (!privateBrowsing()) {
 		QSettings settings{};
@@ -296,7 +403,11 @@ Application::Application(int& argc, char** argv) :
 	}
 
 	// Create or restore window
+	StartupTracer::begin("createWindow");
 	BrowserWindow* window{createWindow(Application::WT_FirstAppWindow, startUrl)};
+	StartupTracer::end();
+
+	StartupTracer::begin("readSession");
 
 	if ((isStartingAfterCrash() && afterCrashLaunch() == RestoreSession) ||
 		(afterLaunch() == RestoreSession || afterLaunch() == OpenSavedSession)) {
@@ -309,6 +420,8 @@ Application::Application(int& argc, char** argv) :
 		}
 	}
 
+	StartupTracer::end();
+
 	// Check for update
 	Updater* updater{new Updater(window)};
 	Q_UNUSED(updater);
@@ -331,12 +444,23 @@ void Application::loadSettings()
 {
 	QSettings settings;
 
+	// Hot settings cache, components reading from it reload themselves
+	SettingsCache::instance()->reload();
+
 	// General Sielo settings
 	m_fullyLoadThemes = settings.value("Settings/fullyLoadThemes", true).toBool();
 	m_useTopToolBar = settings.value("Settings/useTopToolBar", false).toBool();
 	m_hideBookmarksHistoryActions = settings.value("Settings/hideBookmarksHistoryByDefault", false).toBool();
 	m_floatingButtonFoloweMouse = settings.value("Settings/floatingButtonFoloweMouse", true).toBool();
 
+	// Checkpoint the session periodically so it survives a crash (in seconds, 0 to disable)
+	const int checkpointInterval{settings.value("Settings/sessionCheckpointInterval", 30).toInt()};
+
+	if (checkpointInterval > 0)
+		m_sessionCheckpointTimer->start(checkpointInterval * 1000);
+	else
+		m_sessionCheckpointTimer->stop();
+
 	// Load specific settings for all windows
 	foreach (BrowserWindow* window, m_windows) window->loadSettings();
 
@@ -344,6 +468,9 @@ void Application::loadSettings()
 	if (m_autoFill)
 		m_autoFill->loadSettings();
 
+	if (m_tabsLifecycleManager)
+		m_tabsLifecycleManager->loadSettings();
+
 	loadWebSettings();
 	loadApplicationSettings();
 	loadThemesSettings();
@@ -433,52 +560,34 @@ void Application::loadThemesSettings()
 {
 	QSettings settings{};
 
-	// Load theme info
-	QFileInfo themeInfo{
-		paths()[Application::P_Themes] + QLatin1Char('/')
-		+ settings.value("Themes/currentTheme", "sielo-default").toString()
-		+ QLatin1String("/main.sss")
-	};
-
-	// Check if the theme existe
-	if (themeInfo.exists()) {
-		// Check default theme version and update it if needed
-		if (settings.value("Themes/defaultThemeVersion", 1).toInt() < 31) {
-			if (settings.value("Themes/defaultThemeVersion", 1).toInt() < 11) {
-				QString defaultThemePath{paths()[Application::P_Themes]};
-
-				QDir(defaultThemePath + "/bluegrey-flat").removeRecursively();
-				QDir(defaultThemePath + "/cyan-flat").removeRecursively();
-				QDir(defaultThemePath + "/green-flat").removeRecursively();
-				QDir(defaultThemePath + "/indigo-flat").removeRecursively();
-				QDir(defaultThemePath + "/orange-flat").removeRecursively();
-				QDir(defaultThemePath + "/purple-flat").removeRecursively();
-				QDir(defaultThemePath + "/red-flat").removeRecursively();
-				QDir(defaultThemePath + "/sielo-default").removeRecursively();
-				QDir(defaultThemePath + "/teal-flat").removeRecursively();
-				QDir(defaultThemePath + "/white-flat").removeRecursively();
-				QDir(defaultThemePath + "/yellow-flat").removeRecursively();
-
-				loadThemeFromResources("sielo-default", false);
-				settings.setValue("Themes/currentTheme", QLatin1String("sielo-default"));
-			}
+	// Themes shipped with Sielo are read from resources, copies extracted by previous versions are useless
+	if (settings.value("Themes/defaultThemeVersion", 1).toInt() < 32) {
+		const QString themesPath{paths()[Application::P_Themes]};
+		QStringList oldThemes{QDir(RESOURCES_THEMES_PATH).entryList(QDir::Dirs | QDir::NoDotAndDotDot)};
 
-			loadThemeFromResources("firefox-like-light", false);
-			loadThemeFromResources("firefox-like-dark", false);
-			loadThemeFromResources("sielo-default", false);
-			settings.setValue("Themes/defaultThemeVersion", 31);
+		if (settings.value("Themes/defaultThemeVersion", 1).toInt() < 11) {
+			oldThemes << "bluegrey-flat" << "cyan-flat" << "green-flat" << "indigo-flat" << "orange-flat"
+					  << "purple-flat" << "red-flat" << "teal-flat" << "white-flat" << "yellow-flat";
 		}
 
-		loadTheme(settings.value("Themes/currentTheme", QLatin1String("sielo-default")).toString(),
-		          settings.value("Themes/lightness", QLatin1String("dark")).toString());
+		QtConcurrent::run([themesPath, oldThemes]()
+		{
+			foreach (const QString& name, oldThemes) QDir(themesPath + QLatin1Char('/') + name).removeRecursively();
+		});
 
+		settings.setValue("Themes/defaultThemeVersion", 32);
 	}
-	else {
-		loadThemeFromResources("firefox-like-light", false);
-		loadThemeFromResources("firefox-like-dark", false);
-		loadThemeFromResources();
-		settings.setValue("Themes/defaultThemeVersion", 29);
+
+	QString currentTheme{settings.value("Themes/currentTheme", QLatin1String("sielo-default")).toString()};
+
+	// Check if the theme exist
+	if (themePath(currentTheme).isEmpty()
+		&& !QFile::exists(paths()[Application::P_Themes] + QLatin1Char('/') + currentTheme + QLatin1String(".snthm"))) {
+		currentTheme = QLatin1String("sielo-default");
+		settings.setValue("Themes/currentTheme", currentTheme);
 	}
+
+	loadTheme(currentTheme, settings.value("Themes/lightness", QLatin1String("dark")).toString());
 }
 
 void Application::translateApplication()
@@ -538,6 +647,15 @@ QString Application::currentLanguage() const
 	return lang.left(lang.length() - 3);
 }
 
+AutoFill *Application::autoFill()
+{
+	// Created on first use if something needs it before the first window is shown
+	if (!m_autoFill)
+		m_autoFill = new AutoFill;
+
+	return m_autoFill;
+}
+
 QWebEngineProfile *Application::webProfile()
 {
 	if (!m_webProfile) {
@@ -676,40 +794,80 @@ void Application::saveSettings()
 
 void Application::saveSession(bool saveForHome)
 {
-	if (m_privateBrowsing || m_isRestoring || m_windows.count() == 0 || m_restoreManager)
+	if (!canSaveSession())
 		return;
 
-	QByteArray data{};
-	QDataStream stream{&data, QIODevice::WriteOnly};
+	QByteArray data{sessionData()};
 
-	// Write the current session in version 2
-	stream << 0x0003;
-	stream << m_windows.count();
+	// Don't let a pending checkpoint overwrite this save
+	m_sessionWriter.waitForFinished();
+	m_pendingSessionData.clear();
 
-	// Save tabs of all windows
-	foreach (BrowserWindow* window, m_windows) {
-		window->titleBar()->saveToolBarsPositions();
-		stream << window->saveTabs();
+	if (saveForHome) {
+		writeSessionFile(paths()[Application::P_Data] + QLatin1String("/home-session.dat"), data);
+	}
+	else if (writeSessionFile(paths()[Application::P_Data] + QLatin1String("/session.dat"), data)) {
+		m_lastSessionData = data;
+	}
+}
 
-		// Save state of window (is it's in full screen)
-		if (window->isFullScreen())
-			stream << QByteArray();
-		else
-			stream << window->saveState();
+void Application::checkpointSession()
+{
+	if (!canSaveSession() || m_sessionWriter.isRunning())
+		return;
 
-		stream << window->saveGeometry();
-	}
+	QByteArray data{sessionData()};
 
-	// Save data to a file
-	QFile file{};
-	if (saveForHome)
-		file.setFileName(paths()[Application::P_Data] + QLatin1String("/home-session.dat"));
-	else
-		file.setFileName(paths()[Application::P_Data] + QLatin1String("/session.dat"));
+	if (data == m_lastSessionData)
+		return;
+
+	// The checkpoint only counts as saved once written, a failed write is retried on the next one
+	m_pendingSessionData = data;
+	m_sessionWriter.setFuture(QtConcurrent::run(&Application::writeSessionFile,
+												paths()[Application::P_Data] + QLatin1String("/session.dat"), data));
+}
+
+void Application::sessionCheckpointWritten()
+{
+	if (m_pendingSessionData.isEmpty())
+		return;
+
+	if (m_sessionWriter.result())
+		m_lastSessionData = m_pendingSessionData;
+
+	m_pendingSessionData.clear();
+}
+
+bool Application::canSaveSession() const
+{
+	return !(m_privateBrowsing || m_isRestoring || m_windows.count() == 0 || m_restoreManager);
+}
+
+QByteArray Application::sessionData()
+{
+	foreach (BrowserWindow* window, m_windows) window->titleBar()->saveToolBarsPositions();
+
+	return RestoreManager::serialize(m_windows);
+}
+
+bool Application::writeSessionFile(const QString& fileName, const QByteArray& data)
+{
+	// The previous session stay in place until the new one is completely written
+	QSaveFile file{fileName};
+
+	if (!file.open(QIODevice::WriteOnly)) {
+		qWarning() << "Application: cannot open session file" << fileName << file.errorString();
+		return false;
+	}
 
-	file.open(QIODevice::WriteOnly);
 	file.write(data);
-	file.close();
+
+	if (!file.commit()) {
+		qWarning() << "Application: cannot save session file" << fileName << file.errorString();
+		return false;
+	}
+
+	return true;
 }
 
 void Application::reloadUserStyleSheet()
@@ -729,6 +887,8 @@ void Application::quitApplication()
 
 void Application::postLaunch()
 {
+	StartupTracer::Phase phase{"Application::postLaunch"};
+
 	// Check if we want to open a new tab
 	if (m_postLaunchActions.contains(OpenNewTab))
 		getWindow()->tabWidget()->addView(QUrl(), Application::NTT_SelectedNewEmptyTab);
@@ -747,6 +907,32 @@ void Application::postLaunch()
 	connect(this, &Application::aboutToQuit, this, &Application::saveSettings);
 }
 
+void Application::firstWindowShown()
+{
+	if (m_firstWindowShown)
+		return;
+
+	m_firstWindowShown = true;
+	StartupTracer::mark("firstWindowShown");
+
+	// Let the window paint before initializing the rest
+	QTimer::singleShot(0, this, &Application::initDeferredSubsystems);
+}
+
+void Application::initDeferredSubsystems()
+{
+	StartupTracer::begin("initAutoFill");
+	autoFill();
+	StartupTracer::end();
+
+	// Parsing subscriptions is the most expensive part of the startup, it's done last
+	StartupTracer::begin("initAdBlock");
+	ADB::Manager::instance();
+	StartupTracer::end();
+
+	StartupTracer::finish();
+}
+
 void Application::windowDestroyed(QObject* window)
 {
 	Q_ASSERT(static_cast<BrowserWindow*>(window));
@@ -1106,104 +1292,149 @@ void Application::startPrivateBrowsing(const QUrl& startUrl)
 
 void Application::loadTheme(const QString& name, const QString& lightness)
 {
-	QString activeThemePath{Application::instance()->paths()[Application::P_Themes] + QLatin1Char('/') + name};
-	QString sss{readFile(activeThemePath + QLatin1String("/main.sss"))};
+	QString activeThemePath{themePath(name)};
+	QSharedPointer<ThemeArchive> archive{};
+
+	if (activeThemePath.isEmpty())
+		activeThemePath = paths()[Application::P_Themes] + QLatin1Char('/') + name;
+
+	// Themes installed as archives are read in place, without extracting them first
+	if (!QDir(activeThemePath).exists() && QFile::exists(activeThemePath + QLatin1String(".snthm"))) {
+		archive = QSharedPointer<ThemeArchive>::create(activeThemePath + QLatin1String(".snthm"));
+
+		if (archive->isValid()) {
+			activeThemePath = themeArchiveDirectory(name, archive->fileName());
+		}
+		else {
+			qWarning() << "Application: invalid theme archive" << archive->fileName();
+			archive.clear();
+		}
+	}
 
+	{
+		QWriteLocker locker{&appIconsCache->lock};
+
+		appIconsCache->archive = archive;
+		appIconsCache->archiveDirectory = activeThemePath;
+		appIconsCache->archiveIconsPrefix.clear();
+
+		// If the theme use user color API
+		if (archive && archive->containsDirectory("dark") && archive->containsDirectory("light"))
+			appIconsCache->archiveIconsPrefix = lightness + QLatin1Char('/');
+	}
+
+	if (archive) {
+		// Icons come from the archive through getAppIcon
+		QIcon::setThemeName(QString());
+	}
 	// If the theme use user color API
-	if (QDir(activeThemePath + "/dark").exists() && QDir(activeThemePath + "/light").exists()) {
+	else if (QDir(activeThemePath + "/dark").exists() && QDir(activeThemePath + "/light").exists()) {
 		QIcon::setThemeSearchPaths(QStringList() << activeThemePath);
 		QIcon::setThemeName(lightness);
 	}
 	else {
-		QIcon::setThemeSearchPaths(QStringList() << Application::instance()->paths()[Application::P_Themes]);
+		QIcon::setThemeSearchPaths(QStringList() << QFileInfo(activeThemePath).path());
 		QIcon::setThemeName(name);
 	}
 
-	// Load specific theme file for the current OS
+	// Icons from the previous theme must not be served anymore
+	s_themeGeneration.fetchAndAddOrdered(1);
+
 	if (m_fullyLoadThemes) {
+		// Files from an archive are named relatively to the archive root
+		const QString filesPath{archive ? QString() : activeThemePath + QLatin1Char('/')};
+		QStringList files{filesPath + QLatin1String("main.sss")};
+
+		// Load specific theme file for the current OS
 #if defined(Q_OS_MAC)
-		sss.append(readFile(activeThemePath + QLatin1String("/mac.sss")));
+		files.append(filesPath + QLatin1String("mac.sss"));
 #elif defined(Q_OS_LINUX)
-		sss.append(readFile(activeThemePath + QLatin1String("/linux.sss")));
+		files.append(filesPath + QLatin1String("linux.sss"));
 #elif defined(Q_OS_WIN)
-		sss.append(readFile(activeThemePath + QLatin1String("/windows.sss")));
+		files.append(filesPath + QLatin1String("windows.sss"));
 #endif
 
-		QString relativePath{QDir::current().relativeFilePath(activeThemePath)};
+		// Resources paths are the same from everywhere
+		QString relativePath{
+			activeThemePath.startsWith(QLatin1Char(':'))
+			? activeThemePath
+			: QDir::current().relativeFilePath(activeThemePath)
+		};
 
-		sss = parseSSS(sss, relativePath, lightness);
-		//		sss.replace(RegExp(QStringLiteral("scolor\\s*\\(\\s*main\\s*(\\s*,\\s*)\b([0-9]|[1-9][0-9]|1[0-9][0-9]|2[0-4][0-9]|25[0-5])\b\\s*(,\\s*normal))\\s*\\)")), "testeee");
+		// The expanded style sheet is only compiled again when theme files or user colors change
+		StyleSheetCompiler compiler{relativePath, lightness};
+		setStyleSheet(compiler.compileFiles(name, files, archive.data()));
 
-		setStyleSheet(sss);
+		// Images used by the style sheet must be real files for Qt
+		if (archive) {
+			foreach (const QString& url, compiler.urls()) archive->extract(url, activeThemePath);
+		}
 	}
 	else {
 		setStyleSheet("");
 	}
 }
 
-QString Application::parseSSS(QString& sss, const QString& relativePath, const QString& lightness)
+QStringList Application::installedThemes()
 {
-	// Replace url with absolute path
-	sss.replace(RegExp(QStringLiteral("url\\s*\\(\\s*([^\\*:\\);]+)\\s*\\)")),
-	            QString("url(%1/\\1)").arg(relativePath));
+	QStringList themes{QDir(RESOURCES_THEMES_PATH).entryList(QDir::Dirs | QDir::NoDotAndDotDot)};
+	QDir dir{paths()[Application::P_Themes]};
 
-	// Replace some Sielo API properties to Qt properties
-	sss.replace("sproperty", "qproperty");
-	sss.replace("slineargradient", "qlineargradient");
+	// Extracted themes, then themes installed as archives
+	foreach (const QString& name, dir.entryList(QDir::Dirs | QDir::NoDotAndDotDot)) {
+		if (!themes.contains(name))
+			themes.append(name);
+	}
 
-	// Replace theme colors to user colors
-	sss = parseSSSColor(sss, lightness);
+	foreach (const QString& archiveName, dir.entryList(QStringList(QLatin1String("*.snthm")), QDir::Files)) {
+		const QString name{QFileInfo(archiveName).completeBaseName()};
 
-	return sss;
+		if (!themes.contains(name))
+			themes.append(name);
+	}
+
+	return themes;
 }
 
-QString Application::parseSSSColor(QString& sss, const QString& lightness)
+QString Application::themePath(const QString& name)
 {
-	sss.replace(RegExp(QStringLiteral(
-		            "scolor\\s*\\(\\s*(main|second|accent|text)\\s*,\\s*(normal|light|dark)\\s*,\\s*([01]?[0-9]?[0-9]|2[0-4][0-9]|25[0-5])\\s*\\)"
-	            )),
-	            "rgba($color\\1\\2, \\3\\4)");
-	sss.replace(
-		RegExp(QStringLiteral(
-			"scolor\\s*\\(\\s*(main|second|accent|text)\\s*,\\s*(normal|light|dark)\\s*\\)")),
-		"rgba($color\\1\\2, 255)");
-	sss.replace(RegExp(QStringLiteral("scolor\\s*\\(\\s*(main|second|accent|text)\\s*\\)")),
-	            "rgba($color\\1normal, 255)");
-
-	sss.replace(QLatin1String("\\4"), "");
-
-	sss.replace("$colormainlight", AppearancePage::colorString("mainlight"));
-	sss.replace("$colormaindark", AppearancePage::colorString("maindark"));
-	sss.replace("$colormainnormal", AppearancePage::colorString("mainnormal"));
-	sss.replace("$colorsecondlight", AppearancePage::colorString("secondlight"));
-	sss.replace("$colorseconddark", AppearancePage::colorString("seconddark"));
-	sss.replace("$colorsecondnormal", AppearancePage::colorString("secondnormal"));
-	sss.replace("$coloraccentlight", AppearancePage::colorString("accentlight"));
-	sss.replace("$coloraccentdark", AppearancePage::colorString("accentdark"));
-	sss.replace("$coloraccentnormal", AppearancePage::colorString("accentnormal"));
-	sss.replace("$colortextlight", AppearancePage::colorString("textlight"));
-	sss.replace("$colortextdark", AppearancePage::colorString("textdark"));
-	sss.replace("$colortextnormal", AppearancePage::colorString("textnormal"));
-
-	sss.replace("$ulightness", lightness);
+	// Themes shipped with Sielo are loaded directly from resources
+	const QString resourcePath{RESOURCES_THEMES_PATH + QLatin1Char('/') + name};
 
-	return sss;
+	if (!name.isEmpty() && QFile::exists(resourcePath + QLatin1String("/main.sss")))
+		return resourcePath;
+
+	const QString path{paths()[Application::P_Themes] + QLatin1Char('/') + name};
+
+	return !name.isEmpty() && QDir(path).exists() ? path : QString();
 }
 
-void Application::loadThemeFromResources(QString name, bool loadAtEnd)
+QString Application::themeArchiveDirectory(const QString& name, const QString& archiveFile)
 {
-	QString defaultThemePath{paths()[Application::P_Themes]};
-	QString defaultThemeDataPath{":data/themes/" + name};
+	// Entries are extracted on demand in a directory bound to this version of the archive
+	const QString cacheDirectory{paths()[Application::P_Data] + QLatin1String("/cache/themes")};
+	const QString version{QString::number(QFileInfo(archiveFile).lastModified().toMSecsSinceEpoch(), 16)};
+	const QString directoryName{name + QLatin1Char('-') + version};
+
+	QDir dir{cacheDirectory};
 
-	defaultThemePath += QLatin1Char('/') + name;
+	// A glob would also match the directories of other themes whose name starts with this one
+	const QRegularExpression oldDirectoryName{QLatin1Char('^') + QRegularExpression::escape(name)
+											  + QLatin1String("-[0-9a-f]+$")};
+
+	foreach (const QString& oldDirectory, dir.entryList(QStringList(name + QLatin1String("-*")), QDir::Dirs)) {
+		if (oldDirectory != directoryName && oldDirectoryName.match(oldDirectory).hasMatch())
+			QDir(dir.absoluteFilePath(oldDirectory)).removeRecursively();
+	}
 
-	QDir(defaultThemePath).removeRecursively();
-	QDir().mkpath(defaultThemePath + QLatin1String("/images"));
+	return cacheDirectory + QLatin1Char('/') + directoryName;
+}
 
-	copyPath(QDir(defaultThemeDataPath).absolutePath(), defaultThemePath);
+QString Application::parseSSS(QString& sss, const QString& relativePath, const QString& lightness)
+{
+	sss = StyleSheetCompiler(relativePath, lightness).compile(sss);
 
-	if (loadAtEnd)
-		loadTheme(name);
+	return sss;
 }
 
 bool Application::copyPath(const QString& fromDir, const QString& toDir, bool coverFileIfExist)
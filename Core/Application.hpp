@@ -30,6 +30,8 @@
 #include <QList>
 
 #include <QPointer>
+#include <QTimer>
+#include <QFutureWatcher>
 
 #include <QFont>
 
@@ -52,6 +54,8 @@ class Mockups;
 class DownloadManager;
 class HTML5PermissionsManager;
 class NetworkManager;
+class TabsLifecycleManager;
+class TabsMetrics;
 
 class BrowserWindow;
 
@@ -85,6 +89,8 @@ public:
 		/*!< We want to open a new private browsing window */
 		CL_StartNewInstance,
 		/*!< We want to start a new instance of Sielo */
+		CL_TraceStartup,
+		/*!< We want to save a trace of startup phases */
 		CL_ExitAction /*!< We want to close Sielo */
 	};
 
@@ -195,7 +201,9 @@ public:
 	 */
 	void loadTheme(const QString& name, const QString& lightness = "dark");
 	QString parseSSS(QString& sss, const QString& relativePath, const QString& lightness);
-	QString parseSSSColor(QString& sss, const QString& lightness);
+	static QStringList installedThemes();
+	static QString themePath(const QString& name);
+	static QString themeArchiveDirectory(const QString& name, const QString& archiveFile);
 
 	bool privateBrowsing() const { return m_privateBrowsing; }
 	bool isPortable() const { return m_isPortable; }
@@ -229,7 +237,7 @@ public:
 	void destroyRestoreManager();
 
 	PluginProxy *plugins() const { return m_plugins; }
-	AutoFill *autoFill() const { return m_autoFill; }
+	AutoFill *autoFill();
 	CookieJar *cookieJar();
 	History *history();
 	Bookmarks *bookmarks();
@@ -238,6 +246,8 @@ public:
 	HTML5PermissionsManager *permissionsManager();
 	NetworkManager *networkManager() const { return m_networkManager; }
 	RestoreManager *restoreManager() const { return m_restoreManager; }
+	TabsLifecycleManager *tabsLifecycleManager() const { return m_tabsLifecycleManager; }
+	TabsMetrics *tabsMetrics() const { return m_tabsMetrics; }
 
 	QWebEngineProfile *webProfile();
 
@@ -296,19 +306,31 @@ public slots:
 	 * @param saveForHome If true, the saved session will be the user saved session, else, it will be the restore session.
 	 */
 	void saveSession(bool saveForHome = false);
+	/*!
+	 * Save current session in background if something changed since the last save.
+	 */
+	void checkpointSession();
 
 	void reloadUserStyleSheet();
 
 	void quitApplication();
 
+	/*!
+	 * Called by the first window once it is shown. Subsystems not needed to display it are initialized after.
+	 */
+	void firstWindowShown();
+
 private slots:
 	void postLaunch();
+	void initDeferredSubsystems();
 
 	void messageReceived(quint32 instanceId, QByteArray messageBytes);
 	void windowDestroyed(QObject* window);
 
 	void downloadRequested(QWebEngineDownloadItem* download);
 
+	void sessionCheckpointWritten();
+
 private:
 	enum PostLaunchAction {
 		OpenNewTab
@@ -316,7 +338,10 @@ private:
 
 	void setUserStyleSheet(const QString& filePath);
 
-	void loadThemeFromResources(QString name = "sielo-default", bool loadAtEnd = true);
+	bool canSaveSession() const;
+	QByteArray sessionData();
+	static bool writeSessionFile(const QString& fileName, const QByteArray& data);
+
 
 	QString m_languageFile{};
 
@@ -331,6 +356,7 @@ private:
 	bool m_hideBookmarksHistoryActions{false};
 	bool m_floatingButtonFoloweMouse{true};
 	bool m_databaseConnected{false};
+	bool m_firstWindowShown{false};
 
 	AfterLaunch m_afterCrashLaunch{AfterLaunch::OpenHomePage};
 
@@ -348,6 +374,13 @@ private:
 
 	RestoreManager* m_restoreManager{nullptr};
 
+	QTimer* m_sessionCheckpointTimer{nullptr};
+	QFutureWatcher<bool> m_sessionWriter{};
+	QByteArray m_lastSessionData{};
+	QByteArray m_pendingSessionData{};
+	TabsLifecycleManager* m_tabsLifecycleManager{nullptr};
+	TabsMetrics* m_tabsMetrics{nullptr};
+
 	QList<BrowserWindow*> m_windows;
 	QPointer<BrowserWindow> m_lastActiveWindow;
 
@@ -171,25 +171,30 @@ void BrowserWindow::loadSettings()
 	}
 }
 
-QByteArray BrowserWindow::saveTabs()
+QVector<int> BrowserWindow::tabsSpacesLayout() const
 {
-	QByteArray data{};
-	QDataStream stream{&data, QIODevice::WriteOnly};
+	QVector<int> layout{};
+
+	layout.append(m_mainSplitter->count());
 
-	stream << m_mainSplitter->count();
+	for (int i{0}; i < m_mainSplitter->count(); ++i)
+		layout.append(static_cast<QSplitter*>(m_mainSplitter->widget(i))->count());
+
+	return layout;
+}
+
+QVector<TabWidget*> BrowserWindow::tabsSpacesInLayoutOrder() const
+{
+	QVector<TabWidget*> tabWidgets{};
 
 	for (int i{0}; i < m_mainSplitter->count(); ++i) {
 		QSplitter* verticalSplitter = static_cast<QSplitter*>(m_mainSplitter->widget(i));
 
-		stream << verticalSplitter->count();
-
 		for (int j{0}; j < verticalSplitter->count(); ++j)
-			stream << static_cast<TabWidget*>(verticalSplitter->widget(j)->findChild<TabWidget*>(QString("tabwidget")))
-					->saveState();
-
+			tabWidgets.append(verticalSplitter->widget(j)->findChild<TabWidget*>(QString("tabwidget")));
 	}
 
-	return data;
+	return tabWidgets;
 }
 
 void BrowserWindow::setStartTab(WebTab* tab)
@@ -627,6 +632,9 @@ void BrowserWindow::postLaunch()
 
 	show();
 
+	if (m_windowType == Application::WT_FirstAppWindow)
+		Application::instance()->firstWindowShown();
+
 	if (!m_startUrl.isEmpty()) {
 		startUrl = m_startUrl;
 		addTab = true;
@@ -72,7 +72,8 @@ public:
 
 	void loadSettings();
 
-	QByteArray saveTabs();
+	QVector<int> tabsSpacesLayout() const;
+	QVector<TabWidget*> tabsSpacesInLayoutOrder() const;
 
 	void setStartTab(WebTab* tab);
 	void setStartPage(WebPage* page);
@@ -0,0 +1,107 @@
+/***********************************************************************************
+** MIT License                                                                    **
+**                                                                                **
+** Copyright (c) 2018 Victor DENIS (victordenis01@gmail.com)                      **
+**                                                                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+***********************************************************************************/
+
+#include "Cookies/CookieDomainMatcher.hpp"
+
+namespace Sn {
+
+CookieDomainMatcher::CookieDomainMatcher()
+{
+	clear();
+}
+
+void CookieDomainMatcher::compile(const QStringList& domains)
+{
+	clear();
+
+	foreach (const QString& entry, domains) {
+		const QString domain{normalizedDomain(entry)};
+
+		// An empty entry would match every domain
+		if (domain.isEmpty())
+			continue;
+
+		const QVector<QStringRef> labels{domain.splitRef(QLatin1Char('.'))};
+		int node{0};
+
+		for (int i{labels.size() - 1}; i >= 0; --i) {
+			const QString label{labels[i].toString()};
+			int child{m_nodes[node].children.value(label, -1)};
+
+			if (child < 0) {
+				child = m_nodes.size();
+				m_nodes.append(Node());
+				m_nodes[node].children.insert(label, child);
+			}
+
+			node = child;
+		}
+
+		m_nodes[node].terminal = true;
+	}
+
+	m_nodes.squeeze();
+}
+
+void CookieDomainMatcher::clear()
+{
+	m_nodes.clear();
+	m_nodes.append(Node());
+}
+
+bool CookieDomainMatcher::matches(const QString& domain) const
+{
+	if (isEmpty())
+		return false;
+
+	const QString normalized{normalizedDomain(domain)};
+
+	if (normalized.isEmpty())
+		return false;
+
+	const QVector<QStringRef> labels{normalized.splitRef(QLatin1Char('.'))};
+	int node{0};
+
+	for (int i{labels.size() - 1}; i >= 0; --i) {
+		node = m_nodes[node].children.value(labels[i].toString(), -1);
+
+		if (node < 0)
+			return false;
+
+		if (m_nodes[node].terminal)
+			return true;
+	}
+
+	return false;
+}
+
+QString CookieDomainMatcher::normalizedDomain(const QString& domain)
+{
+	if (domain.startsWith(QLatin1Char('.')))
+		return domain.mid(1).toLower();
+
+	return domain.toLower();
+}
+
+}
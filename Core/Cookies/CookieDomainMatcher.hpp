@@ -0,0 +1,63 @@
+/***********************************************************************************
+** MIT License                                                                    **
+**                                                                                **
+** Copyright (c) 2018 Victor DENIS (victordenis01@gmail.com)                      **
+**                                                                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+***********************************************************************************/
+
+#pragma once
+#ifndef SIELO_BROWSER_COOKIEDOMAINMATCHER_HPP
+#define SIELO_BROWSER_COOKIEDOMAINMATCHER_HPP
+
+#include <QHash>
+#include <QVector>
+#include <QStringList>
+
+namespace Sn {
+
+/*
+ * Domain list compiled into a trie of reversed labels ("com" -> "example" -> "www").
+ * A domain matches if it is equal to, or a subdomain of, any domain in the list.
+ * Lookup cost only depends on the number of labels of the tested domain.
+ */
+class CookieDomainMatcher {
+public:
+	CookieDomainMatcher();
+
+	void compile(const QStringList& domains);
+	void clear();
+
+	bool isEmpty() const { return m_nodes.size() <= 1; }
+	bool matches(const QString& domain) const;
+
+private:
+	struct Node {
+		QHash<QString, int> children{};
+		bool terminal{false};
+	};
+
+	static QString normalizedDomain(const QString& domain);
+
+	QVector<Node> m_nodes{};
+};
+
+}
+
+#endif //SIELO_BROWSER_COOKIEDOMAINMATCHER_HPP
@@ -24,10 +24,10 @@
 
 #include "Cookies/CookieJar.hpp"
 
-#include <QSettings>
-
 #include "Application.hpp"
 
+#include "Utils/SettingsCache.hpp"
+
 namespace Sn {
 
 CookieJar::CookieJar(QObject* parent) :
@@ -37,23 +37,21 @@ CookieJar::CookieJar(QObject* parent) :
 	loadSettings();
 	m_client->loadAllCookies();
 
+	connect(SettingsCache::instance(), &SettingsCache::changed, this, &CookieJar::loadSettings);
+
 	connect(m_client, &QWebEngineCookieStore::cookieAdded, this, &CookieJar::sCookieAdded);
 	connect(m_client, &QWebEngineCookieStore::cookieRemoved, this, &CookieJar::sCookieRemoved);
 }
 
 void CookieJar::loadSettings()
 {
-	QSettings settings{};
+	const SettingsCache::CookiePolicy policy{SettingsCache::instance()->cookiePolicy()};
 
-	settings.beginGroup("Cookie-Settings");
-
-	m_allowCookies = settings.value("allowCookies", true).toBool();
-	m_filterThirdParty = settings.value("filterThirdPartyCookies", false).toBool();
-	m_filterTrackingCookie = settings.value("filterTrackingCookies", false).toBool();
-	m_whiteList = settings.value("whiteList", QStringList()).toStringList();
-	m_blackList = settings.value("blackList", QStringList()).toStringList();
-
-	settings.endGroup();
+	m_allowCookies = policy.allowCookies;
+	m_filterThirdParty = policy.filterThirdParty;
+	m_filterTrackingCookie = policy.filterTrackingCookies;
+	m_whiteList.compile(policy.whiteList);
+	m_blackList.compile(policy.blackList);
 }
 
 void CookieJar::setAllowCookies(bool allow)
@@ -88,16 +86,6 @@ bool CookieJar::matchDomain(QString cookieDomain, QString siteDomain) const
 	return siteDomain.indexOf(cookieDomain) > 0 && siteDomain[siteDomain.indexOf(cookieDomain) - 1] == QLatin1Char('.');
 }
 
-bool CookieJar::listMatchesDomain(const QStringList& list, const QString& cookieDomain) const
-{
-		foreach (const QString& domain, list) {
-			if (matchDomain(domain, cookieDomain))
-				return true;
-		}
-
-	return false;
-}
-
 void CookieJar::sCookieAdded(const QNetworkCookie& cookie)
 {
 	if (rejectCookie(QString(), cookie, cookie.domain())) {
@@ -105,14 +93,14 @@ void CookieJar::sCookieAdded(const QNetworkCookie& cookie)
 		return;
 	}
 
-	m_cookies.append(cookie);
+	m_cookies.insert(cookie);
 
 	emit cookieAdded(cookie);
 }
 
 void CookieJar::sCookieRemoved(const QNetworkCookie& cookie)
 {
-	if (m_cookies.removeOne(cookie))
+	if (m_cookies.remove(cookie))
 		emit cookieRemoved(cookie);
 }
 
@@ -129,7 +117,7 @@ bool CookieJar::acceptCookie(const QUrl& firstPartyUrl, const QByteArray& cookie
 bool CookieJar::rejectCookie(const QString& domain, const QNetworkCookie& cookie, const QString& cookieDomain) const
 {
 	if (!m_allowCookies) {
-		bool result{listMatchesDomain(m_whiteList, cookieDomain)};
+		bool result{m_whiteList.matches(cookieDomain)};
 
 		if (!result) {
 			return true;
@@ -137,7 +125,7 @@ bool CookieJar::rejectCookie(const QString& domain, const QNetworkCookie& cookie
 	}
 
 	if (m_allowCookies) {
-		bool result{listMatchesDomain(m_blackList, cookieDomain)};
+		bool result{m_blackList.matches(cookieDomain)};
 
 		if (result)
 			return true;
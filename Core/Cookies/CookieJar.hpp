@@ -31,6 +31,9 @@
 
 #include <QWebEngineCookieStore>
 
+#include "Cookies/CookieStore.hpp"
+#include "Cookies/CookieDomainMatcher.hpp"
+
 namespace Sn {
 
 class CookieJar: public QObject {
@@ -45,7 +48,8 @@ public:
 
 	void deleteCookie(const QNetworkCookie& cookie);
 
-	QVector<QNetworkCookie> getAllCookies() const { return m_cookies; }
+	const CookieStore& cookies() const { return m_cookies; }
+	QVector<QNetworkCookie> getAllCookies() const { return m_cookies.allCookies(); }
 	void deleteAllCookies();
 
 signals:
@@ -54,7 +58,6 @@ signals:
 
 protected:
 	bool matchDomain(QString cookieDomain, QString siteDomain) const;
-	bool listMatchesDomain(const QStringList& list, const QString& cookieDomain) const;
 
 private:
 	void sCookieAdded(const QNetworkCookie& cookie);
@@ -67,11 +70,11 @@ private:
 	bool m_filterTrackingCookie{};
 	bool m_filterThirdParty{};
 
-	QStringList m_whiteList{};
-	QStringList m_blackList{};
+	CookieDomainMatcher m_whiteList{};
+	CookieDomainMatcher m_blackList{};
 
 	QWebEngineCookieStore* m_client{nullptr};
-	QVector<QNetworkCookie> m_cookies{};
+	CookieStore m_cookies{};
 };
 
 }
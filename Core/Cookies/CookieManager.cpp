@@ -35,6 +35,8 @@
 
 #include "Cookies/CookieJar.hpp"
 
+#include "Utils/SettingsCache.hpp"
+
 #include "Widgets/EllipseLabel.hpp"
 
 namespace Sn {
@@ -90,7 +92,15 @@ CookieManager::CookieManager() :
 	connect(Application::instance()->cookieJar(), &CookieJar::cookieAdded, this, &CookieManager::addCookie);
 	connect(Application::instance()->cookieJar(), &CookieJar::cookieRemoved, this, &CookieManager::removeCookie);
 
-		foreach (const QNetworkCookie& cookie, Application::instance()->cookieJar()->getAllCookies()) addCookie(cookie);
+	const CookieStore& cookies{Application::instance()->cookieJar()->cookies()};
+
+	m_cookieTree->setUpdatesEnabled(false);
+
+	foreach (const QString& domain, cookies.domains()) {
+		foreach (const QNetworkCookie& cookie, cookies.cookiesForDomain(domain)) addCookie(cookie);
+	}
+
+	m_cookieTree->setUpdatesEnabled(true);
 }
 
 CookieManager::~CookieManager()
@@ -196,6 +206,7 @@ void CookieManager::removeAll()
 	Application::instance()->cookieJar()->deleteAllCookies();
 
 	m_itemHash.clear();
+	m_cookieItems.clear();
 	m_domainHash.clear();
 	m_cookieTree->clear();
 }
@@ -234,7 +245,16 @@ void CookieManager::filterString(const QString& string)
 
 void CookieManager::addCookie(const QNetworkCookie& cookie)
 {
-	QTreeWidgetItem* item{nullptr};
+	const CookieStore::Key key{CookieStore::keyOf(cookie)};
+	QTreeWidgetItem* item{m_cookieItems.value(key)};
+
+	// The engine reports updated cookies again with the same identity
+	if (item) {
+		item->setData(0, Qt::UserRole + 10, QVariant::fromValue(cookie));
+		m_itemHash[item] = cookie;
+		return;
+	}
+
 	const QString domain{cookieDomain(cookie)};
 	QTreeWidgetItem* findParent{m_domainHash.value(domain)};
 
@@ -258,6 +278,7 @@ void CookieManager::addCookie(const QNetworkCookie& cookie)
 
 	m_cookieTree->addTopLevelItem(item);
 	m_itemHash[item] = cookie;
+	m_cookieItems[key] = item;
 }
 
 void CookieManager::removeCookie(const QNetworkCookie& cookie)
@@ -268,6 +289,7 @@ void CookieManager::removeCookie(const QNetworkCookie& cookie)
 		return;
 
 	m_itemHash.remove(item);
+	m_cookieItems.remove(CookieStore::keyOf(cookie));
 
 	if (item->parent() && item->parent()->childCount() == 1) {
 		m_domainHash.remove(cookieDomain(cookie));
@@ -302,7 +324,7 @@ void CookieManager::closeEvent(QCloseEvent* event)
 
 	settings.endGroup();
 
-	Application::instance()->cookieJar()->loadSettings();
+	SettingsCache::instance()->reload();
 
 	event->accept();
 }
@@ -581,26 +603,12 @@ void CookieManager::addBlackList(const QString& server)
 
 QString CookieManager::cookieDomain(const QNetworkCookie& cookie) const
 {
-	QString domain{cookie.domain()};
-
-	if (domain.startsWith(QLatin1Char('.')))
-		domain = domain.mid(1);
-
-	return domain;
+	return CookieStore::groupDomain(cookie.domain());
 }
 
 QTreeWidgetItem* CookieManager::cookieItem(const QNetworkCookie& cookie) const
 {
-	QHashIterator<QTreeWidgetItem*, QNetworkCookie> it(m_itemHash);
-
-	while (it.hasNext()) {
-		it.next();
-
-		if (it.value() == cookie)
-			return it.key();
-	}
-
-	return nullptr;
+	return m_cookieItems.value(CookieStore::keyOf(cookie), nullptr);
 }
 
 }
\ No newline at end of file
@@ -49,6 +49,8 @@
 
 #include <QHash>
 
+#include "Cookies/CookieStore.hpp"
+
 namespace Sn {
 class EllipseLabel;
 
@@ -155,6 +157,7 @@ private:
 
 	QHash<QString, QTreeWidgetItem*> m_domainHash{};
 	QHash<QTreeWidgetItem*, QNetworkCookie> m_itemHash{};
+	QHash<CookieStore::Key, QTreeWidgetItem*> m_cookieItems{};
 };
 
 }
@@ -0,0 +1,121 @@
+/***********************************************************************************
+** MIT License                                                                    **
+**                                                                                **
+** Copyright (c) 2018 Victor DENIS (victordenis01@gmail.com)                      **
+**                                                                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+***********************************************************************************/
+
+#include "Cookies/CookieStore.hpp"
+
+namespace Sn {
+
+CookieStore::CookieStore()
+{
+	// Empty
+}
+
+CookieStore::Key CookieStore::keyOf(const QNetworkCookie& cookie)
+{
+	Key key{};
+
+	key.domain = cookie.domain();
+	key.path = cookie.path();
+	key.name = cookie.name();
+
+	return key;
+}
+
+QString CookieStore::groupDomain(const QString& cookieDomain)
+{
+	if (cookieDomain.startsWith(QLatin1Char('.')))
+		return cookieDomain.mid(1);
+
+	return cookieDomain;
+}
+
+bool CookieStore::insert(const QNetworkCookie& cookie)
+{
+	const Key key{keyOf(cookie)};
+	const bool isNew{!m_cookies.contains(key)};
+
+	m_cookies.insert(key, cookie);
+
+	if (isNew)
+		m_domains[groupDomain(key.domain)].insert(key);
+
+	return isNew;
+}
+
+bool CookieStore::remove(const QNetworkCookie& cookie)
+{
+	const Key key{keyOf(cookie)};
+
+	if (m_cookies.remove(key) == 0)
+		return false;
+
+	const QString domain{groupDomain(key.domain)};
+	auto it = m_domains.find(domain);
+
+	if (it != m_domains.end()) {
+		it->remove(key);
+
+		if (it->isEmpty())
+			m_domains.erase(it);
+	}
+
+	return true;
+}
+
+void CookieStore::clear()
+{
+	m_cookies.clear();
+	m_domains.clear();
+}
+
+QVector<QNetworkCookie> CookieStore::cookiesForDomain(const QString& domain) const
+{
+	QVector<QNetworkCookie> cookies{};
+	const QSet<Key> keys{m_domains.value(groupDomain(domain))};
+
+	cookies.reserve(keys.size());
+
+	for (const Key& key : keys)
+		cookies.append(m_cookies.value(key));
+
+	return cookies;
+}
+
+QVector<QNetworkCookie> CookieStore::allCookies() const
+{
+	QVector<QNetworkCookie> cookies{};
+	cookies.reserve(m_cookies.size());
+
+	for (auto it = m_cookies.constBegin(); it != m_cookies.constEnd(); ++it)
+		cookies.append(it.value());
+
+	return cookies;
+}
+
+uint qHash(const CookieStore::Key& key, uint seed)
+{
+	return qHash(key.name, qHash(key.path, qHash(key.domain, seed)));
+}
+
+}
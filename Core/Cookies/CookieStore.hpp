@@ -0,0 +1,84 @@
+/***********************************************************************************
+** MIT License                                                                    **
+**                                                                                **
+** Copyright (c) 2018 Victor DENIS (victordenis01@gmail.com)                      **
+**                                                                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+***********************************************************************************/
+
+#pragma once
+#ifndef SIELO_BROWSER_COOKIESTORE_HPP
+#define SIELO_BROWSER_COOKIESTORE_HPP
+
+#include <QHash>
+#include <QSet>
+#include <QVector>
+#include <QStringList>
+
+#include <QNetworkCookie>
+
+namespace Sn {
+
+/*
+ * Cookies indexed by their identity (domain, path, name) with a secondary
+ * index grouping them by domain. Used by the cookie jar to mirror the web engine
+ * cookie store and by the cookie manager to find tree items without scanning.
+ */
+class CookieStore {
+public:
+	struct Key {
+		QString domain{};
+		QString path{};
+		QByteArray name{};
+
+		bool operator==(const Key& other) const
+		{
+			return name == other.name && domain == other.domain && path == other.path;
+		}
+	};
+
+	CookieStore();
+
+	static Key keyOf(const QNetworkCookie& cookie);
+	static QString groupDomain(const QString& cookieDomain);
+
+	bool insert(const QNetworkCookie& cookie);
+	bool remove(const QNetworkCookie& cookie);
+	void clear();
+
+	bool contains(const QNetworkCookie& cookie) const { return m_cookies.contains(keyOf(cookie)); }
+	bool isEmpty() const { return m_cookies.isEmpty(); }
+	int count() const { return m_cookies.count(); }
+
+	QStringList domains() const { return m_domains.keys(); }
+	QVector<QNetworkCookie> cookiesForDomain(const QString& domain) const;
+	QVector<QNetworkCookie> allCookies() const;
+
+private:
+	QHash<Key, QNetworkCookie> m_cookies{};
+	QHash<QString, QSet<Key>> m_domains{};
+};
+
+uint qHash(const CookieStore::Key& key, uint seed = 0);
+
+}
+
+Q_DECLARE_TYPEINFO(Sn::CookieStore::Key, Q_MOVABLE_TYPE);
+
+#endif //SIELO_BROWSER_COOKIESTORE_HPP
@@ -30,6 +30,9 @@
 
 #include "Web/WebView.hpp"
 
+#include "Network/NetworkManager.hpp"
+#include "Network/HttpsUpgradeInterceptor.hpp"
+
 #include "History/HistoryModel.hpp"
 #include <ndb/function.hpp>
 
@@ -261,6 +264,10 @@ void History::clearHistory()
 
 	Application::instance()->webProfile()->clearAllVisitedLinks();
 
+	// Hosts learned over https tell which sites were visited too
+	if (NetworkManager* networkManager = Application::instance()->networkManager())
+		networkManager->httpsUpgradeInterceptor()->clearLearnedHosts();
+
 	emit resetHistory();
 }
 
@@ -188,7 +188,7 @@ void HistoryMenu::aboutToShowClosedTabs()
 
 	TabWidget* tabWidget{ m_window->tabWidget() };
 	int i{ 0 };
-	const QLinkedList<ClosedTabsManager::Tab> closedTabs = tabWidget->closedTabsManager()->allClosedTab();
+	const QVector<ClosedTabsManager::Tab> closedTabs = tabWidget->closedTabsManager()->allClosedTab();
 
 	foreach (const ClosedTabsManager::Tab& tab, closedTabs)
 	{
@@ -27,16 +27,38 @@
 #define SIELOBROWSER_BASEURLINTERCEPTOR_HPP
 
 #include <QObject>
+#include <QAtomicInteger>
 #include <QWebEngineUrlRequestInfo>
 
+#include "Network/LatencyHistogram.hpp"
+
 namespace Sn {
+class RequestContext;
 
 class BaseUrlInterceptor: public QObject {
 public:
 	BaseUrlInterceptor(QObject* parent = nullptr) :
 		QObject(parent) {}
 
-	virtual void interceptRequest(QWebEngineUrlRequestInfo& info) = 0;
+	// The context is built once for all interceptors, it should be used instead of parsing the request again
+	virtual void interceptRequest(const RequestContext& context, QWebEngineUrlRequestInfo& info) = 0;
+
+	// Filled by NetworkUrlInterceptor on the IO thread, can be read from any thread
+	LatencyHistogram& latency() { return m_latency; }
+	const LatencyHistogram& latency() const { return m_latency; }
+	quint64 blockedCount() const { return m_blockedCount.loadAcquire(); }
+
+protected:
+	// Interceptors should block requests with this to have them counted in statistics
+	void blockRequest(QWebEngineUrlRequestInfo& info)
+	{
+		info.block(true);
+		m_blockedCount.fetchAndAddRelaxed(1);
+	}
+
+private:
+	LatencyHistogram m_latency{};
+	QAtomicInteger<quint64> m_blockedCount{0};
 };
 
 }
@@ -0,0 +1,249 @@
+/***********************************************************************************
+** MIT License                                                                    **
+**                                                                                **
+** Copyright (c) 2018 Victor DENIS (victordenis01@gmail.com)                      **
+**                                                                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+***********************************************************************************/
+
+#include "Network/HostSuffixSet.hpp"
+
+#include <QVector>
+#include <QPair>
+
+#include <QtEndian>
+
+#include <algorithm>
+
+namespace Sn {
+
+HostSuffixSet::HostSuffixSet()
+{
+	// Empty
+}
+
+HostSuffixSet::~HostSuffixSet()
+{
+	// Empty
+}
+
+QByteArray HostSuffixSet::compile(const QByteArray& list, const QByteArray& key)
+{
+	QVector<QPair<QByteArray, quint8>> entries{};
+
+	foreach (const QByteArray& rawLine, list.split('\n')) {
+		const QByteArray line{rawLine.trimmed()};
+
+		if (line.isEmpty() || line.startsWith('#'))
+			continue;
+
+		const QList<QByteArray> fields{line.simplified().split(' ')};
+		QByteArray host{fields[0].toLower()};
+
+		// Names are limited to 255 characters, the length is stored on one byte
+		if (host.size() > 255)
+			continue;
+
+		std::reverse(host.begin(), host.end());
+
+		const quint8 flags{fields.count() > 1 && fields[1] == "include_subdomains" ? quint8(IncludeSubdomains) : quint8(0)};
+		entries.append(qMakePair(host, flags));
+	}
+
+	std::sort(entries.begin(), entries.end(), [](const QPair<QByteArray, quint8>& a, const QPair<QByteArray, quint8>& b)
+	{
+		return a.first < b.first;
+	});
+
+	// Duplicated hosts keep the widest flags
+	QVector<QPair<QByteArray, quint8>> uniqueEntries{};
+
+	for (int i{0}; i < entries.count(); ++i) {
+		if (!uniqueEntries.isEmpty() && uniqueEntries.last().first == entries[i].first)
+			uniqueEntries.last().second |= entries[i].second;
+		else
+			uniqueEntries.append(entries[i]);
+	}
+
+	QByteArray data{};
+	const int entriesStart{HeaderSize + uniqueEntries.count() * 4};
+
+	data.resize(entriesStart);
+	data.fill('\0');
+
+	qToLittleEndian<quint32>(Magic, reinterpret_cast<uchar*>(data.data()));
+	qToLittleEndian<quint32>(Version, reinterpret_cast<uchar*>(data.data()) + 4);
+	qToLittleEndian<quint32>(static_cast<quint32>(uniqueEntries.count()), reinterpret_cast<uchar*>(data.data()) + 8);
+	data.replace(12, KeySize, key.left(KeySize).leftJustified(KeySize, '\0'));
+
+	for (int i{0}; i < uniqueEntries.count(); ++i) {
+		qToLittleEndian<quint32>(static_cast<quint32>(data.size() - entriesStart),
+								 reinterpret_cast<uchar*>(data.data()) + HeaderSize + i * 4);
+
+		data.append(static_cast<char>(uniqueEntries[i].second));
+		data.append(static_cast<char>(uniqueEntries[i].first.size()));
+		data.append(uniqueEntries[i].first);
+	}
+
+	return data;
+}
+
+bool HostSuffixSet::open(const QString& fileName, const QByteArray& key)
+{
+	close();
+
+	m_file.setFileName(fileName);
+
+	if (!m_file.open(QIODevice::ReadOnly))
+		return false;
+
+	const uchar* mappedFile{m_file.map(0, m_file.size())};
+	bool loaded{false};
+
+	if (mappedFile)
+		loaded = load(QByteArray::fromRawData(reinterpret_cast<const char*>(mappedFile), static_cast<int>(m_file.size())),
+					  key);
+	else
+		loaded = load(m_file.readAll(), key);
+
+	// The file is released so it can be replaced by an up to date one
+	if (!loaded)
+		close();
+
+	return loaded;
+}
+
+bool HostSuffixSet::setData(const QByteArray& data, const QByteArray& key)
+{
+	close();
+
+	return load(data, key);
+}
+
+void HostSuffixSet::close()
+{
+	m_count = 0;
+	m_offsets = nullptr;
+	m_entries = nullptr;
+	m_data.clear();
+
+	if (m_file.isOpen())
+		m_file.close();
+}
+
+bool HostSuffixSet::matches(const QString& host) const
+{
+	if (!m_entries || host.isEmpty())
+		return false;
+
+	// The host itself, then "example.com" and "com" for "www.example.com"
+	if (find(host, 0) >= 0)
+		return true;
+
+	int dot{host.indexOf(QLatin1Char('.'))};
+
+	while (dot >= 0) {
+		const int flags{find(host, dot + 1)};
+
+		if (flags >= 0 && (flags & IncludeSubdomains))
+			return true;
+
+		dot = host.indexOf(QLatin1Char('.'), dot + 1);
+	}
+
+	return false;
+}
+
+bool HostSuffixSet::load(const QByteArray& data, const QByteArray& key)
+{
+	m_data = data;
+
+	if (m_data.size() < HeaderSize)
+		return false;
+
+	const uchar* header{reinterpret_cast<const uchar*>(m_data.constData())};
+
+	if (qFromLittleEndian<quint32>(header) != Magic || qFromLittleEndian<quint32>(header + 4) != Version)
+		return false;
+
+	if (m_data.mid(12, KeySize) != key.left(KeySize).leftJustified(KeySize, '\0'))
+		return false;
+
+	const quint32 count{qFromLittleEndian<quint32>(header + 8)};
+	const qint64 entriesStart{HeaderSize + static_cast<qint64>(count) * 4};
+
+	if (entriesStart > m_data.size())
+		return false;
+
+	// Entries are checked once here, lookups can then trust offsets and lengths
+	for (quint32 i{0}; i < count; ++i) {
+		const qint64 offset{entriesStart + qFromLittleEndian<quint32>(header + HeaderSize + i * 4)};
+
+		if (offset + 2 > m_data.size() || offset + 2 + header[offset + 1] > m_data.size())
+			return false;
+	}
+
+	m_count = count;
+	m_offsets = header + HeaderSize;
+	m_entries = header + entriesStart;
+
+	return true;
+}
+
+int HostSuffixSet::find(const QString& host, int start) const
+{
+	quint32 low{0};
+	quint32 high{m_count};
+
+	while (low < high) {
+		const quint32 middle{low + (high - low) / 2};
+		const int result{compare(middle, host, start)};
+
+		if (result == 0)
+			return m_entries[qFromLittleEndian<quint32>(m_offsets + middle * 4)];
+
+		if (result < 0)
+			low = middle + 1;
+		else
+			high = middle;
+	}
+
+	return -1;
+}
+
+int HostSuffixSet::compare(quint32 index, const QString& host, int start) const
+{
+	const uchar* entry{m_entries + qFromLittleEndian<quint32>(m_offsets + index * 4)};
+	const int entryLength{entry[1]};
+	const uchar* name{entry + 2};
+	const int hostLength{host.size() - start};
+	const int length{qMin(entryLength, hostLength)};
+
+	// The host is read backward, as entries are stored
+	for (int i{0}; i < length; ++i) {
+		const ushort hostChar{host.at(host.size() - 1 - i).unicode()};
+
+		if (name[i] != hostChar)
+			return name[i] < hostChar ? -1 : 1;
+	}
+
+	return entryLength == hostLength ? 0 : (entryLength < hostLength ? -1 : 1);
+}
+
+}
@@ -0,0 +1,91 @@
+/***********************************************************************************
+** MIT License                                                                    **
+**                                                                                **
+** Copyright (c) 2018 Victor DENIS (victordenis01@gmail.com)                      **
+**                                                                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+***********************************************************************************/
+
+#pragma once
+#ifndef SIELOBROWSER_HOSTSUFFIXSET_HPP
+#define SIELOBROWSER_HOSTSUFFIXSET_HPP
+
+#include <QString>
+#include <QStringList>
+#include <QByteArray>
+
+#include <QFile>
+
+namespace Sn {
+
+/*
+ * Read-only set of host names, looked up straight from a memory mapped file without allocation.
+ *
+ * The file starts with a header (magic, version, entries count, source key), followed by a table of
+ * entries offsets and by the entries. Each entry is its flags, its length and the host name written backward,
+ * entries are sorted on that backward name so hosts and their parents are found with a binary search.
+ */
+class HostSuffixSet {
+public:
+	enum Flag {
+		IncludeSubdomains = 1
+	};
+
+	static const quint32 Magic = 0x534E4853; // "SNHS"
+	static const quint32 Version = 1;
+
+	HostSuffixSet();
+	~HostSuffixSet();
+
+	/*
+	 * Compile a list of hosts, one per line, followed by "include_subdomains" when its subdomains should match.
+	 * Empty lines and lines starting with '#' are ignored. The key is stored to detect outdated files.
+	 */
+	static QByteArray compile(const QByteArray& list, const QByteArray& key);
+
+	// Return false if the file doesn't exist, is invalid or was compiled with another key
+	bool open(const QString& fileName, const QByteArray& key);
+	bool setData(const QByteArray& data, const QByteArray& key);
+	void close();
+
+	bool isValid() const { return m_entries != nullptr; }
+	int count() const { return static_cast<int>(m_count); }
+
+	// True if the host, or one of its parent with IncludeSubdomains, is in the set. The host must be in lower case
+	bool matches(const QString& host) const;
+
+private:
+	static const int KeySize = 20;
+	static const int HeaderSize = 12 + KeySize;
+
+	bool load(const QByteArray& data, const QByteArray& key);
+
+	// Flags of the entry equal to host.mid(start), -1 if there is none
+	int find(const QString& host, int start) const;
+	int compare(quint32 index, const QString& host, int start) const;
+
+	QFile m_file{};
+	QByteArray m_data{};
+	quint32 m_count{0};
+	const uchar* m_offsets{nullptr};
+	const uchar* m_entries{nullptr};
+};
+}
+
+#endif //SIELOBROWSER_HOSTSUFFIXSET_HPP
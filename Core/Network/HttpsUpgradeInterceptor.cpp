@@ -0,0 +1,324 @@
+/***********************************************************************************
+** MIT License                                                                    **
+**                                                                                **
+** Copyright (c) 2018 Victor DENIS (victordenis01@gmail.com)                      **
+**                                                                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+***********************************************************************************/
+
+#include "Network/HttpsUpgradeInterceptor.hpp"
+
+#include <QFile>
+#include <QSaveFile>
+#include <QDir>
+#include <QFileInfo>
+#include <QDateTime>
+
+#include <QCryptographicHash>
+
+#include <QDebug>
+
+#include "Network/RequestContext.hpp"
+
+#include "Utils/SettingsCache.hpp"
+
+#include "Application.hpp"
+
+namespace Sn {
+
+static const QString PRELOAD_LIST_PATH = QStringLiteral(":data/hsts/preload.txt");
+
+HttpsUpgradeInterceptor::HttpsUpgradeInterceptor(QObject* parent) :
+	BaseUrlInterceptor(parent)
+{
+	setObjectName(QStringLiteral("HTTPS Upgrade"));
+
+	loadPreloadList();
+
+	// Hosts visited in private browsing are never written
+	if (!Application::instance()->privateBrowsing()) {
+		loadLearnedHosts();
+		connect(Application::instance(), &QCoreApplication::aboutToQuit, this, &HttpsUpgradeInterceptor::saveLearnedHosts);
+	}
+
+	connect(SettingsCache::instance(), &SettingsCache::changed, this, &HttpsUpgradeInterceptor::loadSettings);
+	loadSettings();
+}
+
+HttpsUpgradeInterceptor::~HttpsUpgradeInterceptor()
+{
+	// Empty
+}
+
+void HttpsUpgradeInterceptor::interceptRequest(const RequestContext& context, QWebEngineUrlRequestInfo& info)
+{
+	if (!m_enabled.loadAcquire() || context.scheme() != QLatin1String("http"))
+		return;
+
+	// Nothing is allocated until we know the request has to be upgraded. Preloaded hosts are upgraded for
+	// every request like with HSTS, learned ones only for main frame navigations, which can fall back to http
+	if (!m_preloadList.matches(context.host())) {
+		if (context.resourceType() != QWebEngineUrlRequestInfo::ResourceTypeMainFrame || !upgradeNavigation(context))
+			return;
+	}
+
+	QUrl url{context.url()};
+
+	url.setScheme(QStringLiteral("https"));
+
+	if (url.port() == 80)
+		url.setPort(-1);
+
+	info.redirect(url);
+}
+
+QUrl HttpsUpgradeInterceptor::navigationFinished(const QUrl& requestedUrl, const QUrl& url, bool ok)
+{
+	const QUrl httpUrl{pendingUpgradeKey(requestedUrl)};
+	bool upgraded{false};
+
+	{
+		QWriteLocker locker{&m_learnedHostsLock};
+		upgraded = m_pendingUpgrades.remove(httpUrl);
+	}
+
+	if (ok) {
+		// Next http:// navigations to this host will be upgraded before being sent
+		if (url.scheme() == QLatin1String("https"))
+			addSecureHost(url.host());
+
+		return QUrl();
+	}
+
+	if (!upgraded)
+		return QUrl();
+
+	// TLS or connection error after our own upgrade, the host may only be reachable over http
+	removeSecureHost(httpUrl.host());
+
+	return httpUrl;
+}
+
+void HttpsUpgradeInterceptor::navigationStopped(const QUrl& requestedUrl)
+{
+	QWriteLocker locker{&m_learnedHostsLock};
+	m_pendingUpgrades.remove(pendingUpgradeKey(requestedUrl));
+}
+
+void HttpsUpgradeInterceptor::addSecureHost(const QString& host)
+{
+	if (host.isEmpty() || m_preloadList.matches(host))
+		return;
+
+	const qint64 now{QDateTime::currentSecsSinceEpoch()};
+
+	QWriteLocker locker{&m_learnedHostsLock};
+
+	if (m_learnedHosts.size() >= MaxLearnedHosts && !m_learnedHosts.contains(host)) {
+		removeExpiredHosts(now);
+
+		if (m_learnedHosts.size() >= MaxLearnedHosts)
+			return;
+	}
+
+	// Each load over https extends the host lifetime
+	m_learnedHosts.insert(host, now);
+	m_learnedHostsChanged = true;
+}
+
+void HttpsUpgradeInterceptor::removeSecureHost(const QString& host)
+{
+	QWriteLocker locker{&m_learnedHostsLock};
+
+	if (m_learnedHosts.remove(host) > 0)
+		m_learnedHostsChanged = true;
+}
+
+bool HttpsUpgradeInterceptor::isSecureHost(const QString& host) const
+{
+	const qint64 now{QDateTime::currentSecsSinceEpoch()};
+
+	QReadLocker locker{&m_learnedHostsLock};
+
+	return m_learnedHosts.value(host, 0) >= now - LearnedHostMaxAge;
+}
+
+void HttpsUpgradeInterceptor::clearLearnedHosts()
+{
+	QWriteLocker locker{&m_learnedHostsLock};
+
+	m_learnedHosts.clear();
+	m_pendingUpgrades.clear();
+	m_learnedHostsChanged = false;
+
+	QFile::remove(learnedHostsFilePath());
+}
+
+void HttpsUpgradeInterceptor::loadSettings()
+{
+	m_enabled.storeRelease(SettingsCache::instance()->upgradeToHttps() ? 1 : 0);
+}
+
+bool HttpsUpgradeInterceptor::upgradeNavigation(const RequestContext& context)
+{
+	const QString& host{context.host()};
+	const qint64 now{QDateTime::currentSecsSinceEpoch()};
+
+	QWriteLocker locker{&m_learnedHostsLock};
+
+	if (m_learnedHosts.value(host, 0) < now - LearnedHostMaxAge)
+		return false;
+
+	const QUrl httpUrl{pendingUpgradeKey(context.url())};
+
+	// The upgraded navigation came back to the same http url: the site redirects to http, upgrading it
+	// again would loop. Other urls of the host, like the ones loaded by other tabs, are still upgraded
+	if (m_pendingUpgrades.remove(httpUrl)) {
+		m_learnedHosts.remove(host);
+		m_learnedHostsChanged = true;
+
+		return false;
+	}
+
+	// Navigations of closed pages are never reported as finished
+	if (m_pendingUpgrades.size() >= MaxPendingUpgrades)
+		m_pendingUpgrades.clear();
+
+	m_pendingUpgrades.insert(httpUrl);
+
+	return true;
+}
+
+QUrl HttpsUpgradeInterceptor::pendingUpgradeKey(QUrl url)
+{
+	// The page may report the http url or its upgraded https version, with a fragment never sent
+	url.setScheme(QStringLiteral("http"));
+	url.setFragment(QString());
+
+	if (url.port() == 80)
+		url.setPort(-1);
+
+	return url;
+}
+
+void HttpsUpgradeInterceptor::removeExpiredHosts(qint64 now)
+{
+	// The learned hosts lock must be held for writing
+	QHash<QString, qint64>::iterator it{m_learnedHosts.begin()};
+
+	while (it != m_learnedHosts.end()) {
+		if (it.value() < now - LearnedHostMaxAge) {
+			it = m_learnedHosts.erase(it);
+			m_learnedHostsChanged = true;
+		}
+		else
+			++it;
+	}
+}
+
+QString HttpsUpgradeInterceptor::cacheFilePath()
+{
+	return Application::paths()[Application::P_Data] + QLatin1String("/cache/hsts-preload.bin");
+}
+
+QString HttpsUpgradeInterceptor::learnedHostsFilePath()
+{
+	return Application::paths()[Application::P_Data] + QLatin1String("/https-hosts.txt");
+}
+
+void HttpsUpgradeInterceptor::loadPreloadList()
+{
+	const QByteArray list{Application::readAllFileByteContents(PRELOAD_LIST_PATH)};
+	const QByteArray key{QCryptographicHash::hash(list, QCryptographicHash::Sha1)};
+	const QString fileName{cacheFilePath()};
+
+	if (m_preloadList.open(fileName, key))
+		return;
+
+	// The list changed with the application, or was never compiled
+	const QByteArray data{HostSuffixSet::compile(list, key)};
+
+	QDir().mkpath(QFileInfo(fileName).path());
+
+	QSaveFile file{fileName};
+
+	if (file.open(QIODevice::WriteOnly)) {
+		file.write(data);
+
+		if (!file.commit())
+			qWarning() << "HttpsUpgradeInterceptor: can't write " << fileName;
+	}
+
+	if (!m_preloadList.open(fileName, key))
+		m_preloadList.setData(data, key);
+}
+
+void HttpsUpgradeInterceptor::loadLearnedHosts()
+{
+	QFile file{learnedHostsFilePath()};
+
+	if (!file.open(QIODevice::ReadOnly))
+		return;
+
+	const qint64 now{QDateTime::currentSecsSinceEpoch()};
+
+	QWriteLocker locker{&m_learnedHostsLock};
+
+	// One "host<tab>last load over https" per line, lines without date come from older versions
+	while (!file.atEnd() && m_learnedHosts.size() < MaxLearnedHosts) {
+		const QList<QByteArray> fields{file.readLine().trimmed().split('\t')};
+		const QString host{QString::fromUtf8(fields[0])};
+		const qint64 lastLoad{fields.size() > 1 ? fields[1].toLongLong() : now};
+
+		if (!host.isEmpty() && lastLoad >= now - LearnedHostMaxAge)
+			m_learnedHosts.insert(host, lastLoad);
+	}
+}
+
+void HttpsUpgradeInterceptor::saveLearnedHosts()
+{
+	QReadLocker locker{&m_learnedHostsLock};
+
+	if (!m_learnedHostsChanged)
+		return;
+
+	QSaveFile file{learnedHostsFilePath()};
+
+	if (!file.open(QIODevice::WriteOnly)) {
+		qWarning() << "HttpsUpgradeInterceptor: can't open " << learnedHostsFilePath();
+		return;
+	}
+
+	const qint64 now{QDateTime::currentSecsSinceEpoch()};
+
+	for (QHash<QString, qint64>::const_iterator it{m_learnedHosts.constBegin()}; it != m_learnedHosts.constEnd(); ++it) {
+		if (it.value() < now - LearnedHostMaxAge)
+			continue;
+
+		file.write(it.key().toUtf8());
+		file.write("\t");
+		file.write(QByteArray::number(it.value()));
+		file.write("\n");
+	}
+
+	if (!file.commit())
+		qWarning() << "HttpsUpgradeInterceptor: can't write " << learnedHostsFilePath();
+}
+
+}
@@ -0,0 +1,99 @@
+/***********************************************************************************
+** MIT License                                                                    **
+**                                                                                **
+** Copyright (c) 2018 Victor DENIS (victordenis01@gmail.com)                      **
+**                                                                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+***********************************************************************************/
+
+#pragma once
+#ifndef SIELOBROWSER_HTTPSUPGRADEINTERCEPTOR_HPP
+#define SIELOBROWSER_HTTPSUPGRADEINTERCEPTOR_HPP
+
+#include <QString>
+#include <QUrl>
+#include <QHash>
+#include <QSet>
+
+#include <QReadWriteLock>
+#include <QAtomicInt>
+
+#include "Network/BaseUrlInterceptor.hpp"
+#include "Network/HostSuffixSet.hpp"
+
+namespace Sn {
+
+/*
+ * Redirect http:// requests to https:// for hosts known to support it, before the plain http request
+ * is sent. Hosts are known from the bundled HSTS preload list, compiled once in the cache directory
+ * and then memory mapped, or because they were already loaded over https.
+ * Learned hosts are only upgraded for main frame navigations and expire after LearnedHostMaxAge. A host is
+ * forgotten, and the navigation done again over http, if the upgraded navigation fails or redirects to http.
+ */
+class HttpsUpgradeInterceptor: public BaseUrlInterceptor {
+public:
+	HttpsUpgradeInterceptor(QObject* parent = nullptr);
+	~HttpsUpgradeInterceptor();
+
+	void interceptRequest(const RequestContext& context, QWebEngineUrlRequestInfo& info);
+
+	// Called when a main frame load finished with the url requested by the page and the one it ended on,
+	// return the http url to load again if the upgrade failed
+	QUrl navigationFinished(const QUrl& requestedUrl, const QUrl& url, bool ok);
+	// Called when a main frame load is stopped by the user, it says nothing about the host
+	void navigationStopped(const QUrl& requestedUrl);
+
+	void addSecureHost(const QString& host);
+	void removeSecureHost(const QString& host);
+	bool isSecureHost(const QString& host) const;
+
+	// Forget every learned host, with the other browsing data
+	void clearLearnedHosts();
+
+	void loadSettings();
+
+	static QString cacheFilePath();
+	static QString learnedHostsFilePath();
+
+private:
+	static const int MaxLearnedHosts = 10000;
+	static const int MaxPendingUpgrades = 100;
+	static const qint64 LearnedHostMaxAge = 60 * 60 * 24 * 30; // In seconds
+
+	bool upgradeNavigation(const RequestContext& context);
+	void removeExpiredHosts(qint64 now);
+
+	static QUrl pendingUpgradeKey(QUrl url);
+
+	void loadPreloadList();
+	void loadLearnedHosts();
+	void saveLearnedHosts();
+
+	QAtomicInt m_enabled{1};
+
+	HostSuffixSet m_preloadList{};
+
+	mutable QReadWriteLock m_learnedHostsLock{};
+	QHash<QString, qint64> m_learnedHosts{}; // Host -> last load over https, in seconds since epoch
+	QSet<QUrl> m_pendingUpgrades{}; // Http urls of upgraded navigations not finished yet, see pendingUpgradeKey()
+	bool m_learnedHostsChanged{false};
+};
+}
+
+#endif //SIELOBROWSER_HTTPSUPGRADEINTERCEPTOR_HPP
@@ -0,0 +1,140 @@
+/***********************************************************************************
+** MIT License                                                                    **
+**                                                                                **
+** Copyright (c) 2018 Victor DENIS (victordenis01@gmail.com)                      **
+**                                                                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+***********************************************************************************/
+
+#include "Network/LatencyHistogram.hpp"
+
+#include <QtAlgorithms>
+
+#include <cmath>
+
+namespace Sn {
+
+LatencyHistogram::LatencyHistogram()
+{
+	// Empty
+}
+
+void LatencyHistogram::add(qint64 nsecs)
+{
+	if (nsecs < 0)
+		nsecs = 0;
+
+	m_buckets[bucketIndex(nsecs)].fetchAndAddRelaxed(1);
+	m_count.fetchAndAddRelaxed(1);
+	m_total.fetchAndAddRelaxed(nsecs);
+
+	qint64 max{m_max.loadAcquire()};
+
+	while (nsecs > max && !m_max.testAndSetOrdered(max, nsecs, max)) {
+		// Another thread changed the maximum, try again with the new one
+	}
+}
+
+quint64 LatencyHistogram::count() const
+{
+	return m_count.loadAcquire();
+}
+
+qint64 LatencyHistogram::max() const
+{
+	return m_max.loadAcquire();
+}
+
+qint64 LatencyHistogram::average() const
+{
+	const quint64 count{m_count.loadAcquire()};
+
+	return count > 0 ? m_total.loadAcquire() / static_cast<qint64>(count) : 0;
+}
+
+qint64 LatencyHistogram::percentile(double percent) const
+{
+	// Buckets are read one by one while other threads can add values, so we work on a snapshot
+	quint64 buckets[BucketsCount];
+	quint64 count{0};
+
+	for (int i{0}; i < BucketsCount; ++i) {
+		buckets[i] = m_buckets[i].loadAcquire();
+		count += buckets[i];
+	}
+
+	if (count == 0)
+		return 0;
+
+	const quint64 rank{qMax<quint64>(1, static_cast<quint64>(std::ceil(count * percent / 100.0)))};
+	const qint64 max{m_max.loadAcquire()};
+	quint64 cumulated{0};
+
+	for (int i{0}; i < BucketsCount; ++i) {
+		cumulated += buckets[i];
+
+		if (cumulated >= rank) {
+			const qint64 upperBound{i + 1 < BucketsCount ? bucketLowerBound(i + 1) - 1 : max};
+			return qMin(upperBound, max);
+		}
+	}
+
+	return max;
+}
+
+QJsonObject LatencyHistogram::toJson() const
+{
+	QJsonObject histogram{};
+
+	histogram.insert("count", static_cast<qint64>(count()));
+	histogram.insert("average", average() / 1000.0);
+	histogram.insert("p50", percentile(50) / 1000.0);
+	histogram.insert("p99", percentile(99) / 1000.0);
+	histogram.insert("max", max() / 1000.0);
+
+	return histogram;
+}
+
+int LatencyHistogram::bucketIndex(qint64 nsecs)
+{
+	if (nsecs < SubBucketsCount)
+		return static_cast<int>(nsecs);
+
+	int power{63 - static_cast<int>(qCountLeadingZeroBits(static_cast<quint64>(nsecs)))};
+
+	if (power > MaxPowerOfTwo)
+		return BucketsCount - 1;
+
+	const int subBucket{static_cast<int>((nsecs >> (power - SubBucketsBits)) & (SubBucketsCount - 1))};
+
+	return (power - SubBucketsBits + 1) * SubBucketsCount + subBucket;
+}
+
+qint64 LatencyHistogram::bucketLowerBound(int index)
+{
+	if (index < SubBucketsCount)
+		return index;
+
+	const int power{index / SubBucketsCount + SubBucketsBits - 1};
+	const qint64 subBucket{index % SubBucketsCount};
+
+	return (SubBucketsCount + subBucket) << (power - SubBucketsBits);
+}
+
+}
@@ -0,0 +1,69 @@
+/***********************************************************************************
+** MIT License                                                                    **
+**                                                                                **
+** Copyright (c) 2018 Victor DENIS (victordenis01@gmail.com)                      **
+**                                                                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+***********************************************************************************/
+
+#pragma once
+#ifndef SIELOBROWSER_LATENCYHISTOGRAM_HPP
+#define SIELOBROWSER_LATENCYHISTOGRAM_HPP
+
+#include <QAtomicInteger>
+
+#include <QJsonObject>
+
+namespace Sn {
+
+/*
+ * Lock-free latency histogram, values are added from any thread and read from any other.
+ * Buckets are log-linear: each power of two is split in 4, so percentiles are at most 25% above the real value
+ */
+class LatencyHistogram {
+public:
+	LatencyHistogram();
+
+	void add(qint64 nsecs);
+
+	quint64 count() const;
+	qint64 max() const;
+	qint64 average() const;
+	qint64 percentile(double percent) const;
+
+	// Latencies are exported in microseconds
+	QJsonObject toJson() const;
+
+private:
+	static const int SubBucketsBits = 2;
+	static const int SubBucketsCount = 1 << SubBucketsBits;
+	static const int MaxPowerOfTwo = 47;
+	static const int BucketsCount = (MaxPowerOfTwo - SubBucketsBits + 2) * SubBucketsCount;
+
+	static int bucketIndex(qint64 nsecs);
+	static qint64 bucketLowerBound(int index);
+
+	QAtomicInteger<quint64> m_buckets[BucketsCount];
+	QAtomicInteger<quint64> m_count{0};
+	QAtomicInteger<qint64> m_total{0};
+	QAtomicInteger<qint64> m_max{0};
+};
+}
+
+#endif //SIELOBROWSER_LATENCYHISTOGRAM_HPP
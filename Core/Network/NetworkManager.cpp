@@ -46,6 +46,7 @@
 
 #include "Network/BaseUrlInterceptor.hpp"
 #include "Network/NetworkUrlInterceptor.hpp"
+#include "Network/HttpsUpgradeInterceptor.hpp"
 
 namespace Sn {
 
@@ -55,6 +56,9 @@ NetworkManager::NetworkManager(QObject* parent) :
 	m_urlInterceptor = new NetworkUrlInterceptor(this);
 	Application::instance()->webProfile()->setRequestInterceptor(m_urlInterceptor);
 
+	m_httpsUpgradeInterceptor = new HttpsUpgradeInterceptor(this);
+	installUrlInterceptor(m_httpsUpgradeInterceptor);
+
 	Application::instance()->cookieJar();
 
 	connect(this,
@@ -217,6 +221,11 @@ void NetworkManager::removeUrlInterceptor(BaseUrlInterceptor* interceptor)
 	m_urlInterceptor->removeUrlInterceptor(interceptor);
 }
 
+QJsonObject NetworkManager::interceptionStatistics() const
+{
+	return m_urlInterceptor->statistics();
+}
+
 void NetworkManager::loadSettings()
 {
 	m_urlInterceptor->loadSettings();
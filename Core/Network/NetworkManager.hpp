@@ -31,10 +31,12 @@
 #include <QAuthenticator>
 
 #include <QHash>
+#include <QJsonObject>
 
 namespace Sn {
 class BaseUrlInterceptor;
 class NetworkUrlInterceptor;
+class HttpsUpgradeInterceptor;
 
 class NetworkManager: public QNetworkAccessManager {
 Q_OBJECT
@@ -48,6 +50,10 @@ public:
 	void installUrlInterceptor(BaseUrlInterceptor* interceptor);
 	void removeUrlInterceptor(BaseUrlInterceptor* interceptor);
 
+	QJsonObject interceptionStatistics() const;
+
+	HttpsUpgradeInterceptor* httpsUpgradeInterceptor() const { return m_httpsUpgradeInterceptor; }
+
 	void loadSettings();
 
 protected:
@@ -56,6 +62,7 @@ protected:
 
 private:
 	NetworkUrlInterceptor* m_urlInterceptor;
+	HttpsUpgradeInterceptor* m_httpsUpgradeInterceptor{nullptr};
 };
 }
 
@@ -25,26 +25,82 @@
 #include "Network/NetworkUrlInterceptor.hpp"
 
 #include <QList>
+#include <QElapsedTimer>
+#include <QFileInfo>
 
-#include <QSettings>
+#include <QJsonArray>
+
+#include <QDebug>
 
 #include "Network/BaseUrlInterceptor.hpp"
+#include "Network/RequestContext.hpp"
+#include "Network/RequestRules.hpp"
+
+#include "Utils/SettingsCache.hpp"
+
+#include "Application.hpp"
 
 namespace Sn {
 
 NetworkUrlInterceptor::NetworkUrlInterceptor(QObject* parent) :
-	QWebEngineUrlRequestInterceptor(parent),
-	m_sendDNT(false)
+	QWebEngineUrlRequestInterceptor(parent)
+{
+	connect(SettingsCache::instance(), &SettingsCache::changed, this, &NetworkUrlInterceptor::loadSettings);
+
+	loadSettings();
+}
+
+NetworkUrlInterceptor::~NetworkUrlInterceptor()
 {
 	// Empty
 }
 
 void NetworkUrlInterceptor::interceptRequest(QWebEngineUrlRequestInfo& info)
 {
-	if (m_sendDNT)
-		info.setHttpHeader(QByteArrayLiteral("DNT"), QByteArrayLiteral("1"));
+	QElapsedTimer timer{};
+	timer.start();
+
+	const RequestContext context{info, &m_domainCache};
+	QSharedPointer<const RequestRules> rules{};
+
+	{
+		QReadLocker locker{&m_requestRulesLock};
+		rules = m_requestRules;
+	}
+
+	bool blocked{false};
+
+	if (rules) {
+		const qint64 start{timer.nsecsElapsed()};
+
+		blocked = rules->apply(context, info);
+		m_requestRulesLatency.add(timer.nsecsElapsed() - start);
+
+		if (blocked)
+			m_requestRulesBlocked.fetchAndAddRelaxed(1);
+	}
+
+	if (!blocked) {
+		foreach (BaseUrlInterceptor* interceptor, m_interceptors) {
+			const quint64 blockedCount{interceptor->blockedCount()};
+			const qint64 start{timer.nsecsElapsed()};
 
-		foreach (BaseUrlInterceptor* interceptor, m_interceptors) interceptor->interceptRequest(info);
+			interceptor->interceptRequest(context, info);
+			interceptor->latency().add(timer.nsecsElapsed() - start);
+
+			if (interceptor->blockedCount() != blockedCount)
+				blocked = true;
+		}
+	}
+
+	m_latency.add(timer.nsecsElapsed());
+
+	const int type{resourceTypeIndex(context.resourceType())};
+
+	if (blocked)
+		m_blockedRequests[type].fetchAndAddRelaxed(1);
+	else
+		m_allowedRequests[type].fetchAndAddRelaxed(1);
 }
 
 void NetworkUrlInterceptor::installUrlInterceptor(BaseUrlInterceptor* interceptor)
@@ -58,15 +114,156 @@ void NetworkUrlInterceptor::removeUrlInterceptor(BaseUrlInterceptor* interceptor
 	m_interceptors.removeOne(interceptor);
 }
 
+QJsonObject NetworkUrlInterceptor::statistics() const
+{
+	QJsonArray interceptors{};
+
+	if (m_requestRulesLatency.count() > 0) {
+		QJsonObject stats{m_requestRulesLatency.toJson()};
+
+		stats.insert("name", QStringLiteral("Request rules"));
+		stats.insert("blocked", static_cast<qint64>(m_requestRulesBlocked.loadAcquire()));
+
+		interceptors.append(stats);
+	}
+
+	foreach (BaseUrlInterceptor* interceptor, m_interceptors) {
+		QJsonObject stats{interceptor->latency().toJson()};
+
+		stats.insert("name", interceptor->objectName().isEmpty() ? QString(interceptor->metaObject()->className())
+															   : interceptor->objectName());
+		stats.insert("blocked", static_cast<qint64>(interceptor->blockedCount()));
+
+		interceptors.append(stats);
+	}
+
+	QJsonArray resourceTypes{};
+
+	for (int i{0}; i < ResourceTypesCount; ++i) {
+		const quint64 allowed{m_allowedRequests[i].loadAcquire()};
+		const quint64 blocked{m_blockedRequests[i].loadAcquire()};
+
+		if (allowed == 0 && blocked == 0)
+			continue;
+
+		QJsonObject resourceType{};
+
+		resourceType.insert("type", resourceTypeName(i));
+		resourceType.insert("allowed", static_cast<qint64>(allowed));
+		resourceType.insert("blocked", static_cast<qint64>(blocked));
+
+		resourceTypes.append(resourceType);
+	}
+
+	QJsonObject statistics{};
+
+	statistics.insert("total", m_latency.toJson());
+	statistics.insert("interceptors", interceptors);
+	statistics.insert("resourceTypes", resourceTypes);
+
+	return statistics;
+}
+
 void NetworkUrlInterceptor::loadSettings()
 {
-	QSettings settings{};
+	const bool doNotTrack{SettingsCache::instance()->sendDoNotTrack()};
+	const QFileInfo fileInfo{requestRulesFilePath()};
+	const QDateTime modified{fileInfo.exists() ? fileInfo.lastModified() : QDateTime()};
+	const qint64 size{fileInfo.exists() ? fileInfo.size() : -1};
+
+	// Settings change for many other reasons, don't parse the rules again for nothing
+	if (m_requestRulesLoaded && doNotTrack == m_requestRulesDoNotTrack && modified == m_requestRulesModified
+		&& size == m_requestRulesSize)
+		return;
+
+	m_requestRulesLoaded = true;
+	m_requestRulesDoNotTrack = doNotTrack;
+	m_requestRulesModified = modified;
+	m_requestRulesSize = size;
+
+	QSharedPointer<RequestRules> rules{new RequestRules()};
+
+	// Do Not Track is the first rule, so user's rules can override it
+	if (doNotTrack) {
+		RequestRules::Rule doNotTrack{};
+
+		doNotTrack.action = RequestRules::SetHeader;
+		doNotTrack.header = QByteArrayLiteral("DNT");
+		doNotTrack.value = QByteArrayLiteral("1");
 
-	settings.beginGroup("Web-Settings");
+		rules->addRule(doNotTrack);
+	}
 
-	m_sendDNT = settings.value("DoNotTrack", false).toBool();
+	QString error{};
 
-	settings.endGroup();
+	if (fileInfo.exists() && !rules->load(fileInfo.filePath(), &error))
+		qWarning() << "NetworkUrlInterceptor: invalid request rules in " << fileInfo.filePath() << ": " << error;
+
+	QSharedPointer<const RequestRules> previousRules{};
+
+	if (!rules->isEmpty())
+		previousRules = rules;
+
+	{
+		QWriteLocker locker{&m_requestRulesLock};
+		m_requestRules.swap(previousRules);
+	}
+
+	// The previous rules are deleted here, out of the lock, unless a request still uses them
+}
+
+QString NetworkUrlInterceptor::resourceTypeName(int type)
+{
+	switch (type) {
+	case QWebEngineUrlRequestInfo::ResourceTypeMainFrame:
+		return QStringLiteral("MainFrame");
+	case QWebEngineUrlRequestInfo::ResourceTypeSubFrame:
+		return QStringLiteral("SubFrame");
+	case QWebEngineUrlRequestInfo::ResourceTypeStylesheet:
+		return QStringLiteral("Stylesheet");
+	case QWebEngineUrlRequestInfo::ResourceTypeScript:
+		return QStringLiteral("Script");
+	case QWebEngineUrlRequestInfo::ResourceTypeImage:
+		return QStringLiteral("Image");
+	case QWebEngineUrlRequestInfo::ResourceTypeFontResource:
+		return QStringLiteral("Font");
+	case QWebEngineUrlRequestInfo::ResourceTypeSubResource:
+		return QStringLiteral("SubResource");
+	case QWebEngineUrlRequestInfo::ResourceTypeObject:
+		return QStringLiteral("Object");
+	case QWebEngineUrlRequestInfo::ResourceTypeMedia:
+		return QStringLiteral("Media");
+	case QWebEngineUrlRequestInfo::ResourceTypeWorker:
+		return QStringLiteral("Worker");
+	case QWebEngineUrlRequestInfo::ResourceTypeSharedWorker:
+		return QStringLiteral("SharedWorker");
+	case QWebEngineUrlRequestInfo::ResourceTypePrefetch:
+		return QStringLiteral("Prefetch");
+	case QWebEngineUrlRequestInfo::ResourceTypeFavicon:
+		return QStringLiteral("Favicon");
+	case QWebEngineUrlRequestInfo::ResourceTypeXhr:
+		return QStringLiteral("Xhr");
+	case QWebEngineUrlRequestInfo::ResourceTypePing:
+		return QStringLiteral("Ping");
+	case QWebEngineUrlRequestInfo::ResourceTypeServiceWorker:
+		return QStringLiteral("ServiceWorker");
+	case QWebEngineUrlRequestInfo::ResourceTypeCspReport:
+		return QStringLiteral("CspReport");
+	case QWebEngineUrlRequestInfo::ResourceTypePluginResource:
+		return QStringLiteral("PluginResource");
+	default:
+		return QStringLiteral("Other");
+	}
+}
+
+QString NetworkUrlInterceptor::requestRulesFilePath()
+{
+	return Application::paths()[Application::P_Data] + QLatin1String("/request-rules.json");
+}
+
+int NetworkUrlInterceptor::resourceTypeIndex(QWebEngineUrlRequestInfo::ResourceType type)
+{
+	return type >= 0 && type < ResourceTypesCount - 1 ? static_cast<int>(type) : ResourceTypesCount - 1;
 }
 
 }
\ No newline at end of file
@@ -28,23 +28,65 @@
 
 #include <QWebEngineUrlRequestInterceptor>
 
+#include <QAtomicInteger>
+#include <QReadWriteLock>
+#include <QSharedPointer>
+#include <QJsonObject>
+
+#include <QDateTime>
+
+#include "Network/LatencyHistogram.hpp"
+#include "Network/RequestContext.hpp"
+
 namespace Sn {
 class BaseUrlInterceptor;
+class RequestRules;
 
 class NetworkUrlInterceptor: public QWebEngineUrlRequestInterceptor {
 public:
 	NetworkUrlInterceptor(QObject* parent = nullptr);
+	~NetworkUrlInterceptor();
 
 	void interceptRequest(QWebEngineUrlRequestInfo& info) Q_DECL_OVERRIDE;
 
 	void installUrlInterceptor(BaseUrlInterceptor* interceptor);
 	void removeUrlInterceptor(BaseUrlInterceptor* interceptor);
 
+	// Latencies of the interceptors and allowed/blocked requests by resource type since startup
+	QJsonObject statistics() const;
+
 	void loadSettings();
 
+	// Unknown and newer resource types are counted in the last slot
+	static const int ResourceTypesCount = 32;
+
+	static QString resourceTypeName(int type);
+	static int resourceTypeIndex(QWebEngineUrlRequestInfo::ResourceType type);
+
+	static QString requestRulesFilePath();
+
 private:
 	QList<BaseUrlInterceptor*> m_interceptors;
-	bool m_sendDNT{false};
+
+	// Only used from the IO thread
+	RegistrableDomainCache m_domainCache{};
+
+	// Replaced from the UI thread when settings change. The IO thread only holds the lock to take a
+	// reference, replaced rules are deleted when the last request using them is done
+	mutable QReadWriteLock m_requestRulesLock{};
+	QSharedPointer<const RequestRules> m_requestRules{};
+
+	// What the current rules were built from, they are only rebuilt when one of these changed
+	bool m_requestRulesLoaded{false};
+	bool m_requestRulesDoNotTrack{false};
+	QDateTime m_requestRulesModified{};
+	qint64 m_requestRulesSize{-1};
+
+	LatencyHistogram m_latency{};
+	LatencyHistogram m_requestRulesLatency{};
+	QAtomicInteger<quint64> m_requestRulesBlocked{0};
+	QAtomicInteger<quint64> m_allowedRequests[ResourceTypesCount];
+	QAtomicInteger<quint64> m_blockedRequests[ResourceTypesCount];
 };
 }
 
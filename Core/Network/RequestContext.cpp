@@ -0,0 +1,90 @@
+/***********************************************************************************
+** MIT License                                                                    **
+**                                                                                **
+** Copyright (c) 2018 Victor DENIS (victordenis01@gmail.com)                      **
+**                                                                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+***********************************************************************************/
+
+#include "Network/RequestContext.hpp"
+
+namespace Sn {
+
+QString RegistrableDomainCache::registrableDomain(const QString& host)
+{
+	QHash<QString, QString>::const_iterator it{m_domains.constFind(host)};
+
+	if (it != m_domains.constEnd())
+		return it.value();
+
+	// A browsing session only sees a few thousands hosts, starting again is cheaper than tracking usage
+	if (m_domains.size() >= MaxSize)
+		m_domains.clear();
+
+	const QString domain{RequestContext::registrableDomain(host)};
+	m_domains.insert(host, domain);
+
+	return domain;
+}
+
+RequestContext::RequestContext(const QWebEngineUrlRequestInfo& info, RegistrableDomainCache* domainCache) :
+	m_url(info.requestUrl()),
+	m_scheme(m_url.scheme()),
+	m_path(m_url.path()),
+	m_resourceType(info.resourceType()),
+	m_encodedUrl(QString::fromLatin1(m_url.toEncoded().toLower())),
+	m_host(m_url.host().toLower()),
+	m_firstPartyUrl(info.firstPartyUrl()),
+	m_firstPartyHost(m_firstPartyUrl.host().toLower())
+{
+	m_domain = domainCache ? domainCache->registrableDomain(m_host) : registrableDomain(m_host);
+
+	if (m_firstPartyHost == m_host)
+		m_firstPartyDomain = m_domain;
+	else
+		m_firstPartyDomain = domainCache ? domainCache->registrableDomain(m_firstPartyHost)
+										 : registrableDomain(m_firstPartyHost);
+}
+
+QString RequestContext::registrableDomain(const QString& host)
+{
+	if (host.isEmpty())
+		return host;
+
+	QUrl url{};
+	url.setHost(host);
+
+	// Public suffix with its leading dot (".co.uk"), empty for ip addresses and unknown suffixes
+	const QString topLevelDomain{url.topLevelDomain()};
+
+	if (topLevelDomain.isEmpty() || topLevelDomain.size() > host.size())
+		return host;
+
+	const int labelEnd{host.size() - topLevelDomain.size()};
+
+	// The host is itself a public suffix
+	if (labelEnd == 0)
+		return host;
+
+	const int labelStart{host.lastIndexOf(QLatin1Char('.'), labelEnd - 1) + 1};
+
+	return host.mid(labelStart);
+}
+
+}
@@ -0,0 +1,94 @@
+/***********************************************************************************
+** MIT License                                                                    **
+**                                                                                **
+** Copyright (c) 2018 Victor DENIS (victordenis01@gmail.com)                      **
+**                                                                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+***********************************************************************************/
+
+#pragma once
+#ifndef SIELOBROWSER_REQUESTCONTEXT_HPP
+#define SIELOBROWSER_REQUESTCONTEXT_HPP
+
+#include <QString>
+#include <QUrl>
+#include <QHash>
+
+#include <QWebEngineUrlRequestInfo>
+
+namespace Sn {
+
+/*
+ * Registrable domains ("example.co.uk" for "www.example.co.uk") of already seen hosts.
+ * Not thread safe, NetworkUrlInterceptor owns one used only from the IO thread
+ */
+class RegistrableDomainCache {
+public:
+	QString registrableDomain(const QString& host);
+
+private:
+	static const int MaxSize = 4096;
+
+	QHash<QString, QString> m_domains{};
+};
+
+/*
+ * Request properties parsed once by NetworkUrlInterceptor, on the IO thread, and given to the request rules
+ * and to every interceptor
+ */
+class RequestContext {
+public:
+	RequestContext(const QWebEngineUrlRequestInfo& info, RegistrableDomainCache* domainCache = nullptr);
+
+	const QUrl& url() const { return m_url; }
+	const QString& scheme() const { return m_scheme; }
+	const QString& path() const { return m_path; }
+	QWebEngineUrlRequestInfo::ResourceType resourceType() const { return m_resourceType; }
+
+	// Lower case encoded url
+	const QString& encodedUrl() const { return m_encodedUrl; }
+
+	// Host names are in lower case
+	const QString& host() const { return m_host; }
+	const QString& domain() const { return m_domain; }
+
+	const QUrl& firstPartyUrl() const { return m_firstPartyUrl; }
+	const QString& firstPartyHost() const { return m_firstPartyHost; }
+	const QString& firstPartyDomain() const { return m_firstPartyDomain; }
+
+	bool isThirdParty() const { return m_domain != m_firstPartyDomain; }
+
+	// Computed with the public suffix list compiled in Qt
+	static QString registrableDomain(const QString& host);
+
+private:
+	QUrl m_url{};
+	QString m_scheme{};
+	QString m_path{};
+	QWebEngineUrlRequestInfo::ResourceType m_resourceType{QWebEngineUrlRequestInfo::ResourceTypeUnknown};
+	QString m_encodedUrl{};
+	QString m_host{};
+	QString m_domain{};
+	QUrl m_firstPartyUrl{};
+	QString m_firstPartyHost{};
+	QString m_firstPartyDomain{};
+};
+}
+
+#endif //SIELOBROWSER_REQUESTCONTEXT_HPP
@@ -0,0 +1,364 @@
+/***********************************************************************************
+** MIT License                                                                    **
+**                                                                                **
+** Copyright (c) 2018 Victor DENIS (victordenis01@gmail.com)                      **
+**                                                                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+***********************************************************************************/
+
+#include "Network/RequestRules.hpp"
+
+#include <QFile>
+#include <QUrlQuery>
+#include <QVarLengthArray>
+
+#include <QJsonDocument>
+#include <QJsonArray>
+#include <QJsonParseError>
+
+#include <algorithm>
+
+#include "Network/RequestContext.hpp"
+#include "Network/NetworkUrlInterceptor.hpp"
+
+namespace Sn {
+
+RequestRules::RequestRules()
+{
+	// Empty
+}
+
+RequestRules::~RequestRules()
+{
+	// Empty
+}
+
+bool RequestRules::load(const QString& fileName, QString* error)
+{
+	QFile file{fileName};
+
+	if (!file.open(QIODevice::ReadOnly)) {
+		if (error)
+			*error = QStringLiteral("can't open %1").arg(fileName);
+		return false;
+	}
+
+	QJsonParseError parseError{};
+	const QJsonDocument document{QJsonDocument::fromJson(file.readAll(), &parseError)};
+
+	if (parseError.error != QJsonParseError::NoError) {
+		if (error)
+			*error = QStringLiteral("%1 at offset %2").arg(parseError.errorString()).arg(parseError.offset);
+		return false;
+	}
+
+	const QJsonArray rules{document.object().value(QStringLiteral("rules")).toArray()};
+	QVector<Rule> parsedRules{};
+
+	// Nothing is added if one rule is invalid
+	for (int i{0}; i < rules.count(); ++i) {
+		Rule rule{};
+		QString ruleError{};
+
+		if (!parseRule(rules[i].toObject(), rule, &ruleError)) {
+			if (error)
+				*error = QStringLiteral("rule %1: %2").arg(i).arg(ruleError);
+			return false;
+		}
+
+		parsedRules.append(rule);
+	}
+
+	foreach (const Rule& rule, parsedRules) addRule(rule);
+
+	return true;
+}
+
+void RequestRules::addRule(const Rule& rule)
+{
+	m_rules.append(rule);
+	indexRule(m_rules.count() - 1);
+}
+
+bool RequestRules::apply(const RequestContext& context, QWebEngineUrlRequestInfo& info) const
+{
+	QVarLengthArray<int, 32> candidates{};
+
+	foreach (int index, m_otherRules) candidates.append(index);
+
+	if (!m_pathsIndex.isEmpty()) {
+		if (const QVector<int>* rules = m_pathsIndex.find(firstPathSegment(context.path())))
+			foreach (int index, *rules) candidates.append(index);
+	}
+
+	if (!m_hostsIndex.isEmpty()) {
+		const QString& host{context.host()};
+		int position{0};
+
+		// Look for "www.example.com", then "example.com", then "com"
+		while (position >= 0 && position < host.size()) {
+			if (const QVector<int>* rules = m_hostsIndex.find(host.midRef(position)))
+				foreach (int index, *rules) candidates.append(index);
+
+			position = host.indexOf(QLatin1Char('.'), position);
+
+			if (position >= 0)
+				++position;
+		}
+	}
+
+	if (candidates.isEmpty())
+		return false;
+
+	// Rules are applied in the file order, a rule can be found with many of its hosts
+	std::sort(candidates.begin(), candidates.end());
+	int* end{std::unique(candidates.begin(), candidates.end())};
+
+	QUrl url{};
+	bool urlChanged{false};
+
+	for (int* index{candidates.begin()}; index != end; ++index) {
+		const Rule& rule{m_rules[*index]};
+
+		if (!match(rule, context))
+			continue;
+
+		switch (rule.action) {
+		case Block:
+			info.block(true);
+			return true;
+		case Redirect:
+			if (rule.target != context.url()) {
+				info.redirect(rule.target);
+				return false;
+			}
+			break;
+		case UpgradeHttps:
+			if (!urlChanged)
+				url = context.url();
+
+			if (url.scheme() == QLatin1String("http")) {
+				url.setScheme(QStringLiteral("https"));
+
+				if (url.port() == 80)
+					url.setPort(-1);
+
+				urlChanged = true;
+			}
+			break;
+		case StripParameters:
+		{
+			if (!(urlChanged ? url.hasQuery() : context.url().hasQuery()))
+				break;
+
+			if (!urlChanged)
+				url = context.url();
+
+			QUrlQuery query{url};
+			const QList<QPair<QString, QString>> items{query.queryItems(QUrl::FullyEncoded)};
+			QList<QPair<QString, QString>> keptItems{};
+
+			for (int i{0}; i < items.count(); ++i) {
+				if (!matchParameter(rule.parameters, items[i].first))
+					keptItems.append(items[i]);
+			}
+
+			if (keptItems.count() != items.count()) {
+				query.setQueryItems(keptItems);
+				url.setQuery(keptItems.isEmpty() ? QString() : query.query(QUrl::FullyEncoded), QUrl::StrictMode);
+				urlChanged = true;
+			}
+			break;
+		}
+		case SetHeader:
+			info.setHttpHeader(rule.header, rule.value);
+			break;
+		}
+	}
+
+	if (urlChanged && url != context.url())
+		info.redirect(url);
+
+	return false;
+}
+
+bool RequestRules::parseRule(const QJsonObject& object, Rule& rule, QString* error)
+{
+	const QString action{object.value(QStringLiteral("action")).toString()};
+
+	if (action == QLatin1String("block"))
+		rule.action = Block;
+	else if (action == QLatin1String("redirect"))
+		rule.action = Redirect;
+	else if (action == QLatin1String("upgradeHttps"))
+		rule.action = UpgradeHttps;
+	else if (action == QLatin1String("stripParameters"))
+		rule.action = StripParameters;
+	else if (action == QLatin1String("setHeader"))
+		rule.action = SetHeader;
+	else {
+		*error = QStringLiteral("unknown action \"%1\"").arg(action);
+		return false;
+	}
+
+	foreach (const QJsonValue& host, object.value(QStringLiteral("hosts")).toArray()) {
+		if (host.toString() == QLatin1String("*")) {
+			rule.hosts.clear();
+			break;
+		}
+
+		rule.hosts.append(host.toString().toLower());
+	}
+
+	rule.pathPrefix = object.value(QStringLiteral("pathPrefix")).toString();
+
+	foreach (const QJsonValue& type, object.value(QStringLiteral("resourceTypes")).toArray()) {
+		int index{-1};
+
+		for (int i{0}; i < NetworkUrlInterceptor::ResourceTypesCount; ++i) {
+			if (NetworkUrlInterceptor::resourceTypeName(i) == type.toString()) {
+				index = i;
+				break;
+			}
+		}
+
+		if (index < 0) {
+			*error = QStringLiteral("unknown resource type \"%1\"").arg(type.toString());
+			return false;
+		}
+
+		rule.resourceTypes |= 1u << index;
+	}
+
+	switch (rule.action) {
+	case Redirect:
+		rule.target = QUrl(object.value(QStringLiteral("target")).toString());
+
+		if (!rule.target.isValid() || rule.target.isRelative()) {
+			*error = QStringLiteral("invalid redirect target");
+			return false;
+		}
+		break;
+	case StripParameters:
+		foreach (const QJsonValue& parameter, object.value(QStringLiteral("parameters")).toArray())
+			rule.parameters.append(parameter.toString());
+
+		if (rule.parameters.isEmpty()) {
+			*error = QStringLiteral("no parameters to strip");
+			return false;
+		}
+		break;
+	case SetHeader:
+		rule.header = object.value(QStringLiteral("header")).toString().toLatin1();
+		rule.value = object.value(QStringLiteral("value")).toString().toLatin1();
+
+		if (rule.header.isEmpty()) {
+			*error = QStringLiteral("no header name");
+			return false;
+		}
+		break;
+	default:
+		break;
+	}
+
+	return true;
+}
+
+bool RequestRules::matchParameter(const QStringList& parameters, const QString& name)
+{
+	foreach (const QString& parameter, parameters) {
+		if (parameter.endsWith(QLatin1Char('*'))) {
+			if (name.startsWith(parameter.leftRef(parameter.size() - 1)))
+				return true;
+		}
+		else if (name == parameter) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+bool RequestRules::match(const Rule& rule, const RequestContext& context) const
+{
+	if (rule.resourceTypes != 0
+		&& !(rule.resourceTypes & (1u << NetworkUrlInterceptor::resourceTypeIndex(context.resourceType()))))
+		return false;
+
+	if (!rule.pathPrefix.isEmpty() && !context.path().startsWith(rule.pathPrefix))
+		return false;
+
+	// Hosts are already matched by the index
+	return true;
+}
+
+void RequestRules::indexRule(int index)
+{
+	const Rule& rule{m_rules[index]};
+
+	if (!rule.hosts.isEmpty()) {
+		foreach (const QString& host, rule.hosts) m_hostsIndex.insert(host, index);
+		return;
+	}
+
+	// Only prefixes with a complete first segment can be indexed, "/ads" also match "/adsense"
+	if (rule.pathPrefix.indexOf(QLatin1Char('/'), 1) > 0) {
+		m_pathsIndex.insert(firstPathSegment(rule.pathPrefix).toString(), index);
+		return;
+	}
+
+	m_otherRules.append(index);
+}
+
+QStringRef RequestRules::firstPathSegment(const QString& path)
+{
+	const int end{path.indexOf(QLatin1Char('/'), 1)};
+
+	return end > 0 ? path.leftRef(end) : path.midRef(0);
+}
+
+void RequestRules::Index::insert(const QString& key, int rule)
+{
+	const uint hash{qHash(key.midRef(0))};
+
+	for (auto it = m_hashes.constFind(hash); it != m_hashes.constEnd() && it.key() == hash; ++it) {
+		if (m_keys[it.value()] == key) {
+			m_values[it.value()].append(rule);
+			return;
+		}
+	}
+
+	m_hashes.insert(hash, m_keys.count());
+	m_keys.append(key);
+	m_values.append(QVector<int>() << rule);
+}
+
+const QVector<int>* RequestRules::Index::find(const QStringRef& key) const
+{
+	const uint hash{qHash(key)};
+
+	for (auto it = m_hashes.constFind(hash); it != m_hashes.constEnd() && it.key() == hash; ++it) {
+		if (m_keys[it.value()] == key)
+			return &m_values[it.value()];
+	}
+
+	return nullptr;
+}
+
+}
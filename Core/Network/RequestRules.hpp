@@ -0,0 +1,126 @@
+/***********************************************************************************
+** MIT License                                                                    **
+**                                                                                **
+** Copyright (c) 2018 Victor DENIS (victordenis01@gmail.com)                      **
+**                                                                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+***********************************************************************************/
+
+#pragma once
+#ifndef SIELOBROWSER_REQUESTRULES_HPP
+#define SIELOBROWSER_REQUESTRULES_HPP
+
+#include <QString>
+#include <QStringList>
+#include <QByteArray>
+#include <QUrl>
+
+#include <QHash>
+#include <QMultiHash>
+#include <QVector>
+
+#include <QJsonObject>
+
+#include <QWebEngineUrlRequestInfo>
+
+namespace Sn {
+class RequestContext;
+
+/*
+ * Declarative rules applied to every request before the interceptors.
+ *
+ * Rules are read from a JSON file: { "rules": [ { "action": ..., ... } ] }, each rule can have
+ *  - "hosts": hosts matched with their subdomains, all hosts when missing
+ *  - "pathPrefix": beginning of the request path
+ *  - "resourceTypes": names from NetworkUrlInterceptor::resourceTypeName(), all types when missing
+ * and one action:
+ *  - "block"
+ *  - "redirect" to "target"
+ *  - "upgradeHttps"
+ *  - "stripParameters": remove query items listed in "parameters" ("utm_*" removes all items starting with "utm_")
+ *  - "setHeader": set "header" to "value". QtWebEngine can't remove a header, an empty value overrides it
+ * Matching rules are applied in the file order.
+ * Rules are indexed by host suffix and by first path segment, so a request is only checked against rules
+ * that can match it. Looking them up doesn't allocate.
+ */
+class RequestRules {
+public:
+	enum Action {
+		Block,
+		Redirect,
+		UpgradeHttps,
+		StripParameters,
+		SetHeader
+	};
+
+	struct Rule {
+		Action action{Block};
+		QStringList hosts{};
+		QString pathPrefix{};
+		quint32 resourceTypes{0}; // Mask of NetworkUrlInterceptor resource type indexes, 0 match all types
+		QUrl target{};
+		QStringList parameters{};
+		QByteArray header{};
+		QByteArray value{};
+	};
+
+	RequestRules();
+	~RequestRules();
+
+	bool load(const QString& fileName, QString* error = nullptr);
+	void addRule(const Rule& rule);
+
+	bool isEmpty() const { return m_rules.isEmpty(); }
+	int count() const { return m_rules.count(); }
+
+	// Return true if the request has been blocked
+	bool apply(const RequestContext& context, QWebEngineUrlRequestInfo& info) const;
+
+private:
+	// Rule indexes by string key, looked up with a QStringRef on the request data instead of a new QString
+	class Index {
+	public:
+		bool isEmpty() const { return m_keys.isEmpty(); }
+
+		void insert(const QString& key, int rule);
+		const QVector<int>* find(const QStringRef& key) const;
+
+	private:
+		QVector<QString> m_keys{};
+		QVector<QVector<int>> m_values{};
+		QMultiHash<uint, int> m_hashes{}; // Hash of a key -> its position in m_keys and m_values
+	};
+
+	static bool parseRule(const QJsonObject& object, Rule& rule, QString* error);
+	static bool matchParameter(const QStringList& parameters, const QString& name);
+
+	bool match(const Rule& rule, const RequestContext& context) const;
+	void indexRule(int index);
+
+	static QStringRef firstPathSegment(const QString& path);
+
+	QVector<Rule> m_rules{};
+
+	Index m_hostsIndex{};
+	Index m_pathsIndex{};
+	QVector<int> m_otherRules{};
+};
+}
+
+#endif //SIELOBROWSER_REQUESTRULES_HPP
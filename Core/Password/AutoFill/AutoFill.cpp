@@ -147,28 +147,32 @@ bool AutoFill::isStoringEnabled(const QUrl& url)
 	if (!m_isStoring)
 		return false;
 
-	QString server{url.host()};
-
-	if (server.isEmpty())
-		server = url.toString();
+	if (!m_exceptionsLoaded) {
+		m_exceptions.clear();
 
-	auto& ids = ndb::query<dbs::password>()
-			<< ((ndb::count(autofill_exceptions.id)) << (autofill_exceptions.server == server));
+		for (auto& entry : ndb::oquery<dbs::password>() << autofill_exceptions)
+			m_exceptions.insert(entry.server);
 
-	if (!ids.has_result())
-		return false;
+		m_exceptionsLoaded = true;
+	}
 
-	return ids[0][0].get<qint64>() <= 0;
+	return !m_exceptions.contains(exceptionServer(url));
 }
 
 void AutoFill::blockStoringForUrl(const QUrl& url)
 {
-	QString server{url.host()};
-
-	if (server.isEmpty())
-		server = url.toString();
+	const QString server{exceptionServer(url)};
 
 	ndb::query<dbs::password>() + (autofill_exceptions.server = server);
+
+	if (m_exceptionsLoaded)
+		m_exceptions.insert(server);
+}
+
+void AutoFill::invalidateExceptions()
+{
+	m_exceptionsLoaded = false;
+	m_exceptions.clear();
 }
 
 QVector<PasswordEntry> AutoFill::getFormData(const QUrl& url)
@@ -314,6 +318,16 @@ QVector<PasswordEntry> AutoFill::completePage(WebPage* page, const QUrl& frameUr
 	return list;
 }
 
+QString AutoFill::exceptionServer(const QUrl& url)
+{
+	QString server{url.host()};
+
+	if (server.isEmpty())
+		server = url.toString();
+
+	return server;
+}
+
 QByteArray AutoFill::exportPasswords()
 {
 	//TODO: do
@@ -29,6 +29,7 @@
 #include <QObject>
 
 #include <QUrl>
+#include <QSet>
 
 namespace Sn {
 class PasswordManager;
@@ -58,6 +59,7 @@ public:
 	bool isStored(const QUrl& url);
 	bool isStoringEnabled(const QUrl& url);
 	void blockStoringForUrl(const QUrl& url);
+	void invalidateExceptions();
 
 	QVector<PasswordEntry> getFormData(const QUrl& url);
 	QVector<PasswordEntry> getAllFormData();
@@ -81,8 +83,13 @@ public:
 
 
 private:
+	static QString exceptionServer(const QUrl& url);
+
 	PasswordManager* m_manager{nullptr};
 	bool m_isStoring{false};
+
+	bool m_exceptionsLoaded{false};
+	QSet<QString> m_exceptions{};
 };
 
 }
@@ -304,6 +304,7 @@ void AutoFillManager::removeException()
 	int id{currentItem->data(0, Qt::UserRole + 10).toInt()};
 
 	ndb::query<dbs::password>() - (autofill_exceptions.id == id);
+	Application::instance()->autoFill()->invalidateExceptions();
 
 	delete currentItem;
 }
@@ -311,6 +312,7 @@ void AutoFillManager::removeException()
 void AutoFillManager::removeAllExceptions()
 {
 	ndb::clear<dbs::password>(autofill_exceptions);
+	Application::instance()->autoFill()->invalidateExceptions();
 
 	m_exceptionsTree->clear();
 }
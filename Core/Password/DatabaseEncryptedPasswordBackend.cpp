@@ -25,6 +25,11 @@
 #include "DatabaseEncryptedPasswordBackend.hpp"
 
 #include <QMessageBox>
+#include <QThread>
+#include <QSettings>
+
+#include <QtConcurrent/QtConcurrentMap>
+#include <QtConcurrent/QtConcurrentRun>
 
 #include "Password/PasswordManager.hpp"
 #include "Password/MasterPasswordDialog.hpp"
@@ -44,9 +49,13 @@ constexpr auto& autofill_encrypted = ndb::models::password.autofill_encrypted;
 
 const QString INTERNAL_SERVER_ID = QLatin1String("sielo.internal");
 
+// Under this number of entries, spreading the work on other threads costs more than it saves
+const int PARALLEL_CRYPTO_THRESHOLD = 32;
+
 namespace Sn {
 
 DatabaseEncryptedPasswordBackend::DatabaseEncryptedPasswordBackend() :
+		QObject(),
 		PasswordBackend(),
 		m_stateOfMasterPassword(UnknownState),
 		m_askPasswordDialogVisible(false),
@@ -57,22 +66,29 @@ DatabaseEncryptedPasswordBackend::DatabaseEncryptedPasswordBackend() :
 
 DatabaseEncryptedPasswordBackend::~DatabaseEncryptedPasswordBackend()
 {
-	// Empty
+	if (m_migrationWatcher) {
+		m_migrationWatcher->disconnect();
+		m_migrationWatcher->waitForFinished();
+		delete m_migrationWatcher;
+	}
+
+	wipeKeys();
+	AesInterface::wipe(m_masterPassword);
 }
 
 QVector<PasswordEntry> DatabaseEncryptedPasswordBackend::getEntries(const QUrl& url)
 {
 	QVector<PasswordEntry> list;
-	AesInterface aesDecryptor{};
 	const QString host{PasswordManager::createHost(url)};
 
 
 	if (hasPermission()) {
-		for (auto& data : ndb::oquery<dbs::password>() << (autofill_encrypted.server == host)) {
-			PasswordEntry entry{ data };
-			if (decryptPasswordEntry(entry, &aesDecryptor))
-				list.append(entry);
-		}
+		for (auto& data : ndb::oquery<dbs::password>() << (autofill_encrypted.server == host))
+			list.append(PasswordEntry{ data });
+
+		prepareKeys(list);
+		decryptPasswordEntries(list, m_keys);
+		migrateDatabaseTable();
 	}
 
 	return list;
@@ -81,22 +97,37 @@ QVector<PasswordEntry> DatabaseEncryptedPasswordBackend::getEntries(const QUrl&
 QVector<PasswordEntry> DatabaseEncryptedPasswordBackend::getAllEntries()
 {
 	QVector<PasswordEntry> list;
-	AesInterface aesDecryptor{};
 
 	if (hasPermission()) {
 		for (auto& data : ndb::oquery<dbs::password>() << autofill_encrypted) {
 			if (data.server == INTERNAL_SERVER_ID)
 				continue;
 
-			PasswordEntry entry{ data };
-			if (decryptPasswordEntry(entry, &aesDecryptor))
-				list.append(entry);
+			list.append(PasswordEntry{ data });
 		}
+
+		prepareKeys(list);
+		decryptPasswordEntries(list, m_keys);
+		migrateDatabaseTable();
 	}
 
 	return list;
 }
 
+QSet<QString> DatabaseEncryptedPasswordBackend::storedHosts()
+{
+	// Servers are stored in clear, no permission is needed to list them
+	QSet<QString> hosts{};
+	auto& query = ndb::query<dbs::password>() << (autofill_encrypted.server);
+
+	for (int i{0}; i < query.size(); ++i)
+		hosts.insert(query[i][0].get<QString>());
+
+	hosts.remove(INTERNAL_SERVER_ID);
+
+	return hosts;
+}
+
 void DatabaseEncryptedPasswordBackend::setActive(bool active)
 {
 	if (active == isActive())
@@ -110,7 +141,7 @@ void DatabaseEncryptedPasswordBackend::setActive(bool active)
 			showMasterPasswordDialog();
 	}
 	else {
-		m_masterPassword.clear();
+		setMasterPassword(QByteArray());
 		setAskMasterPasswordState(isMasterPasswordSetted());
 	}
 }
@@ -240,14 +271,28 @@ bool DatabaseEncryptedPasswordBackend::isPasswordVerified(const QByteArray& pass
 	else if (!m_masterPassword.isEmpty())
 		return false;
 	else {
-		AesInterface aesDecryptor{};
+		// Deriving the key is slow on purpose, it is only done once per unlock
+		const QByteArray sampleData{someDataFromDatabase()};
+		AesInterface::DerivedKey key{};
+
+		if (AesInterface::dataVersion(sampleData) == 1)
+			key = AesInterface::passwordToKey(password);
+		else {
+			const AesInterface::DerivedKey parameters{AesInterface::keyParameters(sampleData)};
+
+			if (parameters.iterations > 0)
+				key = AesInterface::deriveKey(password, parameters.salt, parameters.iterations);
+		}
 
-		aesDecryptor.decrypt(someDataFromDatabase(), password);
+		AesInterface aesDecryptor{};
+		aesDecryptor.decryptWithKey(sampleData, key);
 
 		if (aesDecryptor.isOk()) {
-			m_masterPassword = password;
+			setMasterPassword(password, std::move(key));
 			return true;
 		}
+
+		key.wipe();
 	}
 
 	return false;
@@ -255,18 +300,23 @@ bool DatabaseEncryptedPasswordBackend::isPasswordVerified(const QByteArray& pass
 
 bool DatabaseEncryptedPasswordBackend::decryptPasswordEntry(PasswordEntry& entry, AesInterface* aesInterface)
 {
-	entry.username = QString::fromUtf8(aesInterface->decrypt(entry.username.toUtf8(), m_masterPassword));
-	entry.password = QString::fromUtf8(aesInterface->decrypt(entry.password.toUtf8(), m_masterPassword));
-	entry.data = aesInterface->decrypt(entry.data, m_masterPassword);
+	keyFor(entry.username.toUtf8());
+	keyFor(entry.password.toUtf8());
+	keyFor(entry.data);
 
-	return aesInterface->isOk();
+	return decryptPasswordEntry(entry, aesInterface, m_keys);
 }
 
 bool DatabaseEncryptedPasswordBackend::encryptPasswordEntry(PasswordEntry& entry, AesInterface* aesInterface)
 {
-	entry.username = QString::fromUtf8(aesInterface->encrypt(entry.username.toUtf8(), m_masterPassword));
-	entry.password = QString::fromUtf8(aesInterface->encrypt(entry.password.toUtf8(), m_masterPassword));
-	entry.data = aesInterface->encrypt(entry.data, m_masterPassword);
+	const KeyPointer key{encryptionKey()};
+
+	if (!key)
+		return false;
+
+	entry.username = QString::fromUtf8(aesInterface->encryptWithKey(entry.username.toUtf8(), *key));
+	entry.password = QString::fromUtf8(aesInterface->encryptWithKey(entry.password.toUtf8(), *key));
+	entry.data = aesInterface->encryptWithKey(entry.data, *key);
 
 	return aesInterface->isOk();
 }
@@ -281,9 +331,11 @@ void DatabaseEncryptedPasswordBackend::tryToChangeMasterPassword(const QByteArra
 		return;
 	}
 
-	encryptDatabaseTableOnFly(m_masterPassword, newPassword);
+	AesInterface::DerivedKey newKey{AesInterface::deriveKey(newPassword, QByteArray(), keyDerivationIterations())};
+
+	encryptDatabaseTable(m_masterPassword, newKey);
 
-	m_masterPassword = newPassword;
+	setMasterPassword(newPassword, std::move(newKey));
 
 	updateSampleData(m_masterPassword);
 }
@@ -293,7 +345,7 @@ void DatabaseEncryptedPasswordBackend::removeMasterPassword()
 	if (!m_masterPassword.isEmpty()) {
 		encryptDatabaseTableOnFly(m_masterPassword, QByteArray());
 
-		m_masterPassword.clear();
+		setMasterPassword(QByteArray());
 		updateSampleData(QByteArray());
 	}
 }
@@ -301,6 +353,9 @@ void DatabaseEncryptedPasswordBackend::removeMasterPassword()
 void DatabaseEncryptedPasswordBackend::setAskMasterPasswordState(bool ask)
 {
 	m_askMasterPassword = ask;
+
+	if (ask)
+		emit locked();
 }
 
 void DatabaseEncryptedPasswordBackend::encryptDatabaseTableOnFly(const QByteArray& decryptorPassword,
@@ -309,35 +364,14 @@ void DatabaseEncryptedPasswordBackend::encryptDatabaseTableOnFly(const QByteArra
 	if (encryptorPassword == decryptorPassword)
 		return;
 
-	AesInterface encryptor;
-	AesInterface decryptor;
-
-	for (auto& qdata : ndb::oquery<dbs::password>() << autofill_encrypted) {
-		if (qdata.server == INTERNAL_SERVER_ID)
-			continue;
-
-		int id{qdata.id};
-		QByteArray data = qdata.data_encrypted.toUtf8();
-		QByteArray password = qdata.password_encrypted.toUtf8();
-		QByteArray username = qdata.username_encrypted.toUtf8();
+	AesInterface::DerivedKey encryptorKey{};
 
-		if (!decryptorPassword.isEmpty()) {
-			data = decryptor.decrypt(data, decryptorPassword);
-			password = decryptor.decrypt(password, decryptorPassword);
-			username = decryptor.decrypt(username, decryptorPassword);
-		}
+	if (!encryptorPassword.isEmpty())
+		encryptorKey = AesInterface::deriveKey(encryptorPassword, QByteArray(), keyDerivationIterations());
 
-		if (!encryptorPassword.isEmpty()) {
-			data = encryptor.encrypt(data, encryptorPassword);
-			password = encryptor.encrypt(password, encryptorPassword);
-			username = encryptor.encrypt(username, encryptorPassword);
-		}
+	encryptDatabaseTable(decryptorPassword, encryptorKey);
 
-		ndb::query<dbs::password>() >> ((autofill_encrypted.data_encrypted = QString::fromUtf8(data),
-										 autofill_encrypted.password_encrypted = QString::fromUtf8(password),
-										 autofill_encrypted.username_encrypted = QString::fromUtf8(username))
-				<< (autofill_encrypted.id == id));
-	}
+	encryptorKey.wipe();
 }
 
 void DatabaseEncryptedPasswordBackend::updateSampleData(const QByteArray& password)
@@ -348,7 +382,12 @@ void DatabaseEncryptedPasswordBackend::updateSampleData(const QByteArray& passwo
 		if (!password.isEmpty()) {
 			AesInterface aesInterface{};
 
-			m_someDataStoredOnDatabase = aesInterface.encrypt(AesInterface::createRandomData(16), password);
+			const KeyPointer key{password == m_masterPassword ? encryptionKey() : KeyPointer()};
+
+			if (key)
+				m_someDataStoredOnDatabase = aesInterface.encryptWithKey(AesInterface::createRandomData(16), *key);
+			else
+				m_someDataStoredOnDatabase = aesInterface.encrypt(AesInterface::createRandomData(16), password);
 
 			if (data.has_result()) {
 				ndb::query<dbs::password>()
@@ -375,6 +414,374 @@ void DatabaseEncryptedPasswordBackend::updateSampleData(const QByteArray& passwo
 		}
 }
 
+void DatabaseEncryptedPasswordBackend::setMasterPassword(const QByteArray& password, AesInterface::DerivedKey key)
+{
+	// Never keep the keys of a previous master password around
+	if (m_masterPassword != password) {
+		wipeKeys();
+		AesInterface::wipe(m_masterPassword);
+		m_masterPassword = password;
+	}
+
+	if (key.isValid()) {
+		const KeyPointer sharedKey{new AesInterface::DerivedKey(std::move(key))};
+
+		m_keys.insert(sharedKey->id(), sharedKey);
+
+		if (!sharedKey->isLegacy())
+			m_encryptionKey = sharedKey;
+	}
+}
+
+void DatabaseEncryptedPasswordBackend::wipeKeys()
+{
+	// Keys still used by a pending migration are erased once it releases them
+	m_keys.clear();
+	m_encryptionKey.clear();
+
+	++m_keysGeneration;
+	m_migrationChecked = false;
+
+	emit locked();
+}
+
+DatabaseEncryptedPasswordBackend::KeyPointer DatabaseEncryptedPasswordBackend::keyFor(const QByteArray& cipherData)
+{
+	const QByteArray id{AesInterface::keyId(cipherData)};
+
+	if (id.isEmpty())
+		return KeyPointer();
+
+	auto it = m_keys.constFind(id);
+
+	if (it != m_keys.constEnd())
+		return it.value();
+
+	AesInterface::DerivedKey key{};
+
+	if (AesInterface::dataVersion(cipherData) == 1)
+		key = AesInterface::passwordToKey(m_masterPassword);
+	else {
+		const AesInterface::DerivedKey parameters{AesInterface::keyParameters(cipherData)};
+
+		if (parameters.iterations > 0)
+			key = AesInterface::deriveKey(m_masterPassword, parameters.salt, parameters.iterations);
+	}
+
+	if (!key.isValid())
+		return KeyPointer();
+
+	const KeyPointer sharedKey{new AesInterface::DerivedKey(std::move(key))};
+	m_keys.insert(id, sharedKey);
+
+	return sharedKey;
+}
+
+DatabaseEncryptedPasswordBackend::KeyPointer DatabaseEncryptedPasswordBackend::encryptionKey()
+{
+	if (m_encryptionKey)
+		return m_encryptionKey;
+
+	// Reuse the salt of the stored datas so all entries share one key
+	const QByteArray sampleData{someDataFromDatabase()};
+
+	if (AesInterface::dataVersion(sampleData) == 2)
+		m_encryptionKey = keyFor(sampleData);
+
+	if (!m_encryptionKey) {
+		AesInterface::DerivedKey key{AesInterface::deriveKey(m_masterPassword, QByteArray(), keyDerivationIterations())};
+
+		if (key.isValid()) {
+			m_encryptionKey = KeyPointer(new AesInterface::DerivedKey(std::move(key)));
+			m_keys.insert(m_encryptionKey->id(), m_encryptionKey);
+		}
+	}
+
+	return m_encryptionKey;
+}
+
+void DatabaseEncryptedPasswordBackend::prepareKeys(const QVector<PasswordEntry>& entries)
+{
+	foreach (const PasswordEntry& entry, entries) {
+		keyFor(entry.username.toUtf8());
+		keyFor(entry.password.toUtf8());
+		keyFor(entry.data);
+	}
+}
+
+DatabaseEncryptedPasswordBackend::KeyRing DatabaseEncryptedPasswordBackend::keysForRows(
+	const QVector<EncryptedRow>& rows, const QByteArray& password)
+{
+	KeyRing keys{};
+
+	foreach (const EncryptedRow& row, rows) {
+		foreach (const QByteArray& cipherData, QList<QByteArray>() << row.data << row.password << row.username) {
+			const QByteArray id{AesInterface::keyId(cipherData)};
+
+			if (id.isEmpty() || keys.contains(id))
+				continue;
+
+			if (password == m_masterPassword) {
+				const KeyPointer key{keyFor(cipherData)};
+
+				if (key)
+					keys.insert(id, key);
+
+				continue;
+			}
+
+			AesInterface::DerivedKey key{};
+
+			if (AesInterface::dataVersion(cipherData) == 1)
+				key = AesInterface::passwordToKey(password);
+			else {
+				const AesInterface::DerivedKey parameters{AesInterface::keyParameters(cipherData)};
+
+				if (parameters.iterations > 0)
+					key = AesInterface::deriveKey(password, parameters.salt, parameters.iterations);
+			}
+
+			if (key.isValid())
+				keys.insert(id, KeyPointer(new AesInterface::DerivedKey(std::move(key))));
+		}
+	}
+
+	return keys;
+}
+
+void DatabaseEncryptedPasswordBackend::encryptDatabaseTable(const QByteArray& decryptorPassword,
+															const AesInterface::DerivedKey& encryptorKey)
+{
+	QVector<EncryptedRow> rows{};
+
+	for (auto& qdata : ndb::oquery<dbs::password>() << autofill_encrypted) {
+		if (qdata.server == INTERNAL_SERVER_ID)
+			continue;
+
+		EncryptedRow row{};
+		row.id = qdata.id;
+		row.data = qdata.data_encrypted.toUtf8();
+		row.password = qdata.password_encrypted.toUtf8();
+		row.username = qdata.username_encrypted.toUtf8();
+
+		rows.append(row);
+	}
+
+	// Keys are derived once for the whole table instead of for every field
+	KeyRing decryptorKeys{};
+
+	if (!decryptorPassword.isEmpty())
+		decryptorKeys = keysForRows(rows, decryptorPassword);
+
+	auto convertRow = [&decryptorPassword, &decryptorKeys, &encryptorKey](EncryptedRow& row) {
+		AesInterface encryptor;
+		AesInterface decryptor;
+
+		if (!decryptorPassword.isEmpty()) {
+			row.data = decryptField(row.data, &decryptor, decryptorKeys);
+			row.password = decryptField(row.password, &decryptor, decryptorKeys);
+			row.username = decryptField(row.username, &decryptor, decryptorKeys);
+		}
+
+		if (encryptorKey.isValid()) {
+			row.data = encryptor.encryptWithKey(row.data, encryptorKey);
+			row.password = encryptor.encryptWithKey(row.password, encryptorKey);
+			row.username = encryptor.encryptWithKey(row.username, encryptorKey);
+		}
+	};
+
+	if (rows.size() < PARALLEL_CRYPTO_THRESHOLD || QThread::idealThreadCount() < 2) {
+		for (EncryptedRow& row : rows)
+			convertRow(row);
+	}
+	else
+		QtConcurrent::blockingMap(rows, convertRow);
+
+	// Keys derived for another password are erased here, the master password ones stay in m_keys
+	decryptorKeys.clear();
+
+	for (const EncryptedRow& row : rows) {
+		ndb::query<dbs::password>() >> ((autofill_encrypted.data_encrypted = QString::fromUtf8(row.data),
+										 autofill_encrypted.password_encrypted = QString::fromUtf8(row.password),
+										 autofill_encrypted.username_encrypted = QString::fromUtf8(row.username))
+				<< (autofill_encrypted.id == row.id));
+	}
+}
+
+void DatabaseEncryptedPasswordBackend::migrateDatabaseTable()
+{
+	if (m_migrationChecked || m_migrationWatcher)
+		return;
+
+	m_migrationChecked = true;
+
+	QVector<EncryptedRow> rows{};
+
+	for (auto& qdata : ndb::oquery<dbs::password>() << autofill_encrypted) {
+		EncryptedRow row{};
+		row.id = qdata.id;
+		row.data = qdata.data_encrypted.toUtf8();
+		row.password = qdata.password_encrypted.toUtf8();
+		row.username = qdata.username_encrypted.toUtf8();
+
+		if (AesInterface::dataVersion(row.data) == 1 || AesInterface::dataVersion(row.password) == 1
+			|| AesInterface::dataVersion(row.username) == 1)
+			rows.append(row);
+	}
+
+	if (rows.isEmpty())
+		return;
+
+	const KeyRing keys{keysForRows(rows, m_masterPassword)};
+	const KeyPointer encryptorKey{encryptionKey()};
+	const int generation{m_keysGeneration};
+
+	if (!encryptorKey)
+		return;
+
+	// Version 1 datas are re-encrypted off the GUI thread, then written back if nothing changed meanwhile
+	m_migrationWatcher = new QFutureWatcher<QVector<EncryptedRow>>();
+
+	QObject::connect(m_migrationWatcher, &QFutureWatcher<QVector<EncryptedRow>>::finished, [this, rows, generation]() {
+		const QVector<EncryptedRow> migratedRows{m_migrationWatcher->result()};
+
+		m_migrationWatcher->deleteLater();
+		m_migrationWatcher = nullptr;
+
+		if (generation != m_keysGeneration)
+			return;
+
+		for (int i{0}; i < migratedRows.size(); ++i) {
+			const EncryptedRow& original{rows[i]};
+			const EncryptedRow& migrated{migratedRows[i]};
+			bool unchanged{false};
+
+			for (auto& qdata : ndb::oquery<dbs::password>() << (autofill_encrypted.id == original.id)) {
+				unchanged = qdata.data_encrypted.toUtf8() == original.data
+							&& qdata.password_encrypted.toUtf8() == original.password
+							&& qdata.username_encrypted.toUtf8() == original.username;
+			}
+
+			if (!unchanged)
+				continue;
+
+			ndb::query<dbs::password>() >> ((autofill_encrypted.data_encrypted = QString::fromUtf8(migrated.data),
+											 autofill_encrypted.password_encrypted = QString::fromUtf8(migrated.password),
+											 autofill_encrypted.username_encrypted = QString::fromUtf8(migrated.username))
+					<< (autofill_encrypted.id == original.id));
+		}
+
+		// The sample data may have been migrated too
+		m_stateOfMasterPassword = UnknownState;
+		m_someDataStoredOnDatabase.clear();
+	});
+
+	m_migrationWatcher->setFuture(QtConcurrent::run([rows, keys, encryptorKey]() {
+		QVector<EncryptedRow> migratedRows{rows};
+		AesInterface aesInterface{};
+
+		auto migrateField = [&aesInterface, &keys, &encryptorKey](QByteArray& cipherData) {
+			if (AesInterface::dataVersion(cipherData) != 1)
+				return;
+
+			const QByteArray plainData{decryptField(cipherData, &aesInterface, keys)};
+
+			if (!aesInterface.isOk())
+				return;
+
+			const QByteArray migratedData{aesInterface.encryptWithKey(plainData, *encryptorKey)};
+
+			if (aesInterface.isOk())
+				cipherData = migratedData;
+		};
+
+		for (EncryptedRow& row : migratedRows) {
+			migrateField(row.data);
+			migrateField(row.password);
+			migrateField(row.username);
+		}
+
+		return migratedRows;
+	}));
+}
+
+int DatabaseEncryptedPasswordBackend::keyDerivationIterations()
+{
+	QSettings settings{};
+
+	return qBound(AesInterface::MIN_KDF_ITERATIONS,
+				  settings.value("PasswordManager/keyDerivationIterations", AesInterface::DEFAULT_KDF_ITERATIONS).toInt(),
+				  AesInterface::MAX_KDF_ITERATIONS);
+}
+
+QByteArray DatabaseEncryptedPasswordBackend::decryptField(const QByteArray& cipherData, AesInterface* aesInterface,
+														  const KeyRing& keys)
+{
+	const KeyPointer key{keys.value(AesInterface::keyId(cipherData))};
+
+	if (!key)
+		return aesInterface->decryptWithKey(cipherData, AesInterface::DerivedKey());
+
+	return aesInterface->decryptWithKey(cipherData, *key);
+}
+
+bool DatabaseEncryptedPasswordBackend::decryptPasswordEntry(PasswordEntry& entry, AesInterface* aesInterface,
+															const KeyRing& keys)
+{
+	bool ok{true};
+
+	entry.username = QString::fromUtf8(decryptField(entry.username.toUtf8(), aesInterface, keys));
+	ok = ok && aesInterface->isOk();
+	entry.password = QString::fromUtf8(decryptField(entry.password.toUtf8(), aesInterface, keys));
+	ok = ok && aesInterface->isOk();
+	entry.data = decryptField(entry.data, aesInterface, keys);
+
+	return ok && aesInterface->isOk();
+}
+
+void DatabaseEncryptedPasswordBackend::decryptPasswordEntries(QVector<PasswordEntry>& entries, const KeyRing& keys)
+{
+	QVector<char> decrypted(entries.size(), false);
+
+	if (entries.size() < PARALLEL_CRYPTO_THRESHOLD || QThread::idealThreadCount() < 2) {
+		AesInterface aesDecryptor{};
+
+		for (int i{0}; i < entries.size(); ++i)
+			decrypted[i] = decryptPasswordEntry(entries[i], &aesDecryptor, keys);
+	}
+	else {
+		// One slice of entries per thread, so each thread reuses its own cipher contexts
+		const int sliceCount{QThread::idealThreadCount()};
+		const int sliceSize{(entries.size() + sliceCount - 1) / sliceCount};
+
+		QVector<int> slices{};
+		for (int i{0}; i < entries.size(); i += sliceSize)
+			slices.append(i);
+
+		PasswordEntry* entriesData{entries.data()};
+		char* decryptedData{decrypted.data()};
+		const int count{entries.size()};
+
+		QtConcurrent::blockingMap(slices, [entriesData, decryptedData, count, sliceSize, &keys](int begin) {
+			AesInterface aesDecryptor{};
+			const int end{qMin(begin + sliceSize, count)};
+
+			for (int i{begin}; i < end; ++i)
+				decryptedData[i] = decryptPasswordEntry(entriesData[i], &aesDecryptor, keys);
+		});
+	}
+
+	QVector<PasswordEntry> result{};
+	result.reserve(entries.size());
+
+	for (int i{0}; i < entries.size(); ++i) {
+		if (decrypted[i])
+			result.append(entries[i]);
+	}
+
+	entries = result;
+}
+
 void DatabaseEncryptedPasswordBackend::showMasterPasswordDialog()
 {
 	MasterPasswordDialog* masterPasswordDialog{new MasterPasswordDialog(this, Application::instance()->getWindow())};
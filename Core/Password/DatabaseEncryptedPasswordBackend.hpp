@@ -27,13 +27,21 @@
 #define SIELO_BROWSER_DATABASEENCRYPTEDPASSWORDBACKEND_HPP
 
 #include <QVector>
+#include <QHash>
+#include <QSharedPointer>
+
+#include <QObject>
+#include <QFutureWatcher>
 
 #include "Password/PasswordBackend.hpp"
 
+#include "Utils/AesInterface.hpp"
+
 namespace Sn {
-class AesInterface;
 
-class DatabaseEncryptedPasswordBackend: public PasswordBackend {
+class DatabaseEncryptedPasswordBackend: public QObject, public PasswordBackend {
+Q_OBJECT
+
 public:
 	enum MasterPasswordState {
 		PasswordIsSetted,
@@ -47,6 +55,9 @@ public:
 	QVector<PasswordEntry> getEntries(const QUrl& url);
 	QVector<PasswordEntry> getAllEntries();
 
+	QSet<QString> storedHosts();
+	bool isLocked() const { return m_askMasterPassword; }
+
 	void setActive(bool active);
 
 	void addEntry(const PasswordEntry& entry);
@@ -82,15 +93,54 @@ public:
 
 	void showMasterPasswordDialog();
 
+signals:
+	// Decrypted datas kept elsewhere must be dropped when this is emitted
+	void locked();
+
 private:
+	// Keys are shared, never copied, and erased when their last owner releases them
+	using KeyPointer = QSharedPointer<const AesInterface::DerivedKey>;
+	// Derived keys by key id, see AesInterface::keyId()
+	using KeyRing = QHash<QByteArray, KeyPointer>;
+
+	struct EncryptedRow {
+		int id{};
+		QByteArray data{};
+		QByteArray password{};
+		QByteArray username{};
+	};
+
 	QByteArray someDataFromDatabase();
 
+	void setMasterPassword(const QByteArray& password, AesInterface::DerivedKey key = AesInterface::DerivedKey());
+	void wipeKeys();
+
+	KeyPointer keyFor(const QByteArray& cipherData);
+	KeyPointer encryptionKey();
+	void prepareKeys(const QVector<PasswordEntry>& entries);
+	KeyRing keysForRows(const QVector<EncryptedRow>& rows, const QByteArray& password);
+
+	void encryptDatabaseTable(const QByteArray& decryptorPassword, const AesInterface::DerivedKey& encryptorKey);
+	void migrateDatabaseTable();
+
+	static int keyDerivationIterations();
+	static QByteArray decryptField(const QByteArray& cipherData, AesInterface* aesInterface, const KeyRing& keys);
+	static bool decryptPasswordEntry(PasswordEntry& entry, AesInterface* aesInterface, const KeyRing& keys);
+	static void decryptPasswordEntries(QVector<PasswordEntry>& entries, const KeyRing& keys);
+
 	MasterPasswordState m_stateOfMasterPassword{};
 	QByteArray m_someDataStoredOnDatabase{};
 
 	bool m_askPasswordDialogVisible{false};
 	bool m_askMasterPassword{false};
 	QByteArray m_masterPassword{};
+
+	KeyRing m_keys{};
+	KeyPointer m_encryptionKey{};
+	int m_keysGeneration{0};
+
+	bool m_migrationChecked{false};
+	QFutureWatcher<QVector<EncryptedRow>>* m_migrationWatcher{nullptr};
 };
 
 }
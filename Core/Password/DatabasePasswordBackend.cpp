@@ -68,6 +68,17 @@ QVector<PasswordEntry> DatabasePasswordBackend::getAllEntries()
 	return list;
 }
 
+QSet<QString> DatabasePasswordBackend::storedHosts()
+{
+	QSet<QString> hosts{};
+	auto& query = ndb::query<dbs::password>() << (autofill.server);
+
+	for (int i{0}; i < query.size(); ++i)
+		hosts.insert(query[i][0].get<QString>());
+
+	return hosts;
+}
+
 void DatabasePasswordBackend::addEntry(const PasswordEntry& entry)
 {
 	if (entry.data.isEmpty()) {
@@ -42,6 +42,8 @@ public:
 	QVector<PasswordEntry> getEntries(const QUrl& url);
 	QVector<PasswordEntry> getAllEntries();
 
+	QSet<QString> storedHosts();
+
 	void addEntry(const PasswordEntry& entry);
 	bool updateEntry(const PasswordEntry& entry);
 	void updateLastUsed(PasswordEntry& entry);
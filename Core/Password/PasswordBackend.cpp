@@ -37,6 +37,20 @@ PasswordBackend::~PasswordBackend()
 	// Empty
 }
 
+QSet<QString> PasswordBackend::storedHosts()
+{
+	QSet<QString> hosts{};
+
+	foreach (const PasswordEntry& entry, getAllEntries()) hosts.insert(entry.host);
+
+	return hosts;
+}
+
+bool PasswordBackend::isLocked() const
+{
+	return false;
+}
+
 void PasswordBackend::setActive(bool active)
 {
 	m_active = active;
@@ -29,6 +29,7 @@
 #include <QWidget>
 
 #include <QVector>
+#include <QSet>
 
 #include "Password/PasswordManager.hpp"
 
@@ -43,6 +44,11 @@ public:
 	virtual QVector<PasswordEntry> getEntries(const QUrl& url) = 0;
 	virtual QVector<PasswordEntry> getAllEntries() = 0;
 
+	// Hosts having at least one entry, used to skip lookups for other hosts
+	virtual QSet<QString> storedHosts();
+	// A locked backend asks for permission before returning entries, they must not be cached
+	virtual bool isLocked() const;
+
 	virtual void addEntry(const PasswordEntry& entry) = 0;
 	virtual bool updateEntry(const PasswordEntry& entry) = 0;
 	virtual void updateLastUsed(PasswordEntry& entry) = 0;
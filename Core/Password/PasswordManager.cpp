@@ -117,6 +117,9 @@ PasswordManager::PasswordManager(QObject* parent) :
 {
 	m_backends["database"] = m_databaseBackend;
 	m_backends["database-encrypted"] = m_databaseEncryptedBackend;
+
+	connect(m_databaseEncryptedBackend, &DatabaseEncryptedPasswordBackend::locked, this,
+			&PasswordManager::invalidateCache);
 }
 
 PasswordManager::~PasswordManager()
@@ -137,7 +140,32 @@ void PasswordManager::loadSettings()
 QVector<PasswordEntry> PasswordManager::getEntries(const QUrl& url)
 {
 	ensureLoaded();
-	return m_backend->getEntries(url);
+
+	const QString host{createHost(url)};
+
+	if (!m_storedHostsLoaded) {
+		m_storedHosts = m_backend->storedHosts();
+		m_storedHostsLoaded = true;
+	}
+
+	if (!m_storedHosts.contains(host))
+		return QVector<PasswordEntry>();
+
+	if (m_backend->isLocked())
+		m_entriesCache.clear();
+	else {
+		auto it = m_entriesCache.constFind(host);
+
+		if (it != m_entriesCache.constEnd())
+			return it.value();
+	}
+
+	const QVector<PasswordEntry> entries{m_backend->getEntries(url)};
+
+	if (!m_backend->isLocked())
+		m_entriesCache.insert(host, entries);
+
+	return entries;
 }
 
 QVector<PasswordEntry> PasswordManager::getAllEntries()
@@ -150,30 +178,43 @@ void PasswordManager::addEntry(const PasswordEntry& entry)
 {
 	ensureLoaded();
 	m_backend->addEntry(entry);
+
+	invalidateCache();
 }
 
 bool PasswordManager::updateEntry(const PasswordEntry& entry)
 {
 	ensureLoaded();
-	return m_backend->updateEntry(entry);
+
+	const bool updated{m_backend->updateEntry(entry)};
+
+	invalidateCache();
+
+	return updated;
 }
 
 void PasswordManager::updateLastUsed(PasswordEntry& entry)
 {
 	ensureLoaded();
 	m_backend->updateLastUsed(entry);
+
+	invalidateCache();
 }
 
 void PasswordManager::removeEntry(const PasswordEntry& entry)
 {
 	ensureLoaded();
 	m_backend->removeEntry(entry);
+
+	invalidateCache();
 }
 
 void PasswordManager::removeAllEntries()
 {
 	ensureLoaded();
 	m_backend->removeAll();
+
+	invalidateCache();
 }
 
 QHash<QString, PasswordBackend*> PasswordManager::availableBackends()
@@ -199,6 +240,8 @@ void PasswordManager::switchBackend(const QString& backendID)
 	m_backend = backend;
 	m_backend->setActive(true);
 
+	invalidateCache();
+
 	QSettings settings{};
 
 	settings.setValue("PasswordManager/backend", backendID);
@@ -221,8 +264,17 @@ void PasswordManager::unregisterBackend(PasswordBackend* backend)
 
 	m_backends.remove(key);
 
-	if (m_backend == backend)
+	if (m_backend == backend) {
 		m_backend = m_databaseBackend;
+		invalidateCache();
+	}
+}
+
+void PasswordManager::invalidateCache()
+{
+	m_storedHostsLoaded = false;
+	m_storedHosts.clear();
+	m_entriesCache.clear();
 }
 
 void PasswordManager::ensureLoaded()
@@ -36,6 +36,7 @@
 #include <QDataStream>
 
 #include <QHash>
+#include <QSet>
 #include <QVector>
 
 #include <ndb/query.hpp>
@@ -127,6 +128,8 @@ public:
 	bool registerBackend(const QString& id, PasswordBackend* backend);
 	void unregisterBackend(PasswordBackend* backend);
 
+	void invalidateCache();
+
 	static QString createHost(const QUrl& url);
 	static QByteArray urlEncodePassword(const QString& password);
 	static QByteArray passwordToHash(const QString& masterPassword);
@@ -145,6 +148,11 @@ private:
 
 	QHash<QString, PasswordBackend*> m_backends;
 
+	// Lookup cache, entries by host as given by createHost()
+	bool m_storedHostsLoaded{false};
+	QSet<QString> m_storedHosts{};
+	QHash<QString, QVector<PasswordEntry>> m_entriesCache{};
+
 };
 
 }
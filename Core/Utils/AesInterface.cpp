@@ -31,9 +31,71 @@
 #include <QDebug>
 #include <QMessageBox>
 
+#include <QApplication>
+#include <QThread>
+
 namespace Sn {
 
-const int AesInterface::VERSION = 1;
+const int AesInterface::VERSION = 2;
+const int AesInterface::DEFAULT_KDF_ITERATIONS = 310000;
+const int AesInterface::MIN_KDF_ITERATIONS = 10000;
+const int AesInterface::MAX_KDF_ITERATIONS = 10 * AesInterface::DEFAULT_KDF_ITERATIONS;
+
+static const int KEY_LENGTH = 32;
+static const int SALT_LENGTH = 16;
+static const int GCM_NONCE_LENGTH = 12;
+static const int GCM_TAG_LENGTH = 16;
+
+AesInterface::SecureKey::SecureKey(const uchar* data, int size) :
+	m_data(data, data + size)
+{
+	// Empty
+}
+
+AesInterface::SecureKey::SecureKey(SecureKey&& other) noexcept :
+	m_data(std::move(other.m_data))
+{
+	other.m_data.clear();
+}
+
+AesInterface::SecureKey::~SecureKey()
+{
+	wipe();
+}
+
+AesInterface::SecureKey& AesInterface::SecureKey::operator=(SecureKey&& other) noexcept
+{
+	if (this != &other) {
+		wipe();
+		m_data = std::move(other.m_data);
+		other.m_data.clear();
+	}
+
+	return *this;
+}
+
+void AesInterface::SecureKey::wipe()
+{
+	if (!m_data.empty())
+		OPENSSL_cleanse(m_data.data(), m_data.size());
+
+	m_data.clear();
+}
+
+QByteArray AesInterface::DerivedKey::id() const
+{
+	if (isLegacy())
+		return QByteArray::number(1);
+
+	return QByteArray::number(2) + '$' + QByteArray::number(iterations) + '$' + salt.toBase64();
+}
+
+void AesInterface::DerivedKey::wipe()
+{
+	key.wipe();
+	salt.clear();
+	iterations = 0;
+}
 
 QByteArray AesInterface::createRandomData(int length)
 {
@@ -48,52 +110,216 @@ QByteArray AesInterface::createRandomData(int length)
 	return data;
 }
 
+AesInterface::DerivedKey AesInterface::deriveKey(const QByteArray& password, const QByteArray& salt, int iterations)
+{
+	DerivedKey result{};
+	uchar key[KEY_LENGTH];
+
+	result.salt = salt.isEmpty() ? createRandomData(SALT_LENGTH) : salt;
+	result.iterations = qMax(1, iterations);
+
+	int success{PKCS5_PBKDF2_HMAC(password.constData(),
+								  password.size(),
+								  (uchar*) result.salt.constData(),
+								  result.salt.size(),
+								  result.iterations,
+								  EVP_sha256(),
+								  KEY_LENGTH,
+								  key)};
+
+	if (success != 1) {
+		qWarning() << "Key derivation failed";
+		OPENSSL_cleanse(key, sizeof(key));
+		return DerivedKey();
+	}
+
+	result.key = SecureKey(key, KEY_LENGTH);
+	OPENSSL_cleanse(key, sizeof(key));
+
+	return result;
+}
+
+AesInterface::DerivedKey AesInterface::passwordToKey(const QByteArray& password)
+{
+	DerivedKey result{};
+	const int nrounds{5};
+	uchar key[EVP_MAX_KEY_LENGTH];
+
+	int keyLength{EVP_BytesToKey(EVP_aes_256_cbc(),
+								 EVP_sha256(),
+								 nullptr,
+								 (uchar*) password.data(),
+								 password.size(),
+								 nrounds,
+								 key,
+								 nullptr)};
+
+	if (keyLength != KEY_LENGTH) {
+		qWarning("Key size is %d bits - should be 256 bits", keyLength * 8);
+		OPENSSL_cleanse(key, sizeof(key));
+		return result;
+	}
+
+	result.key = SecureKey(key, keyLength);
+	OPENSSL_cleanse(key, sizeof(key));
+
+	return result;
+}
+
+int AesInterface::dataVersion(const QByteArray& cipherData)
+{
+	const int separator{cipherData.indexOf('$')};
+
+	if (separator <= 0)
+		return 0;
+
+	return cipherData.left(separator).toInt();
+}
+
+QByteArray AesInterface::keyId(const QByteArray& cipherData)
+{
+	const int version{dataVersion(cipherData)};
+
+	if (version == 1)
+		return QByteArray::number(1);
+
+	if (version == 2) {
+		const QList<QByteArray> cipherSections{cipherData.split('$')};
+
+		if (cipherSections.size() == 4)
+			return cipherSections[0] + '$' + cipherSections[1] + '$' + cipherSections[2];
+	}
+
+	return QByteArray();
+}
+
+AesInterface::DerivedKey AesInterface::keyParameters(const QByteArray& cipherData)
+{
+	DerivedKey parameters{};
+
+	if (dataVersion(cipherData) == 2) {
+		const QList<QByteArray> cipherSections{cipherData.split('$')};
+
+		bool ok{false};
+		const int iterations{cipherSections.size() == 4 ? cipherSections[1].toInt(&ok) : 0};
+
+		// The count comes from the stored datas, don't let it make the derivation run forever
+		if (ok && iterations >= MIN_KDF_ITERATIONS && iterations <= MAX_KDF_ITERATIONS) {
+			parameters.iterations = iterations;
+			parameters.salt = QByteArray::fromBase64(cipherSections[2]);
+		}
+	}
+
+	return parameters;
+}
+
+void AesInterface::wipe(QByteArray& data)
+{
+	// Writing to a shared buffer would detach it and only erase the new copy
+	if (!data.isEmpty() && data.isDetached())
+		OPENSSL_cleanse(data.data(), data.size());
+
+	data.clear();
+}
+
 AesInterface::AesInterface(QObject* parent) :
 	QObject(parent),
 	m_ok(false)
 {
 	m_encodedCTX = EVP_CIPHER_CTX_new();
 	m_decodedCTX = EVP_CIPHER_CTX_new();
+	m_legacyDecodedCTX = EVP_CIPHER_CTX_new();
 	EVP_CIPHER_CTX_init(m_encodedCTX);
 	EVP_CIPHER_CTX_init(m_decodedCTX);
+	EVP_CIPHER_CTX_init(m_legacyDecodedCTX);
 }
 
 AesInterface::~AesInterface()
 {
 	EVP_CIPHER_CTX_cleanup(m_encodedCTX);
 	EVP_CIPHER_CTX_cleanup(m_decodedCTX);
+	EVP_CIPHER_CTX_cleanup(m_legacyDecodedCTX);
 	EVP_CIPHER_CTX_free(m_encodedCTX);
 	EVP_CIPHER_CTX_free(m_decodedCTX);
+	EVP_CIPHER_CTX_free(m_legacyDecodedCTX);
 }
 
 QByteArray AesInterface::encrypt(const QByteArray& plainData, const QByteArray& password)
 {
-	if (!init(EVP_PKEY_MO_ENCRYPT, password)) {
-		m_ok = false;
+	DerivedKey key{deriveKey(password)};
+	QByteArray result{encryptWithKey(plainData, key)};
+
+	key.wipe();
+
+	return result;
+}
+
+QByteArray AesInterface::decrypt(const QByteArray& cipherData, const QByteArray& password)
+{
+	DerivedKey key{};
+
+	if (dataVersion(cipherData) == 1)
+		key = passwordToKey(password);
+	else {
+		const DerivedKey parameters{keyParameters(cipherData)};
+
+		if (parameters.iterations > 0)
+			key = deriveKey(password, parameters.salt, parameters.iterations);
+	}
+
+	QByteArray result{decryptWithKey(cipherData, key)};
+
+	key.wipe();
+
+	return result;
+}
+
+QByteArray AesInterface::encryptWithKey(const QByteArray& plainData, const DerivedKey& key)
+{
+	m_ok = false;
+
+	if (!key.isValid() || key.isLegacy()) {
+		qWarning() << "Encrypt error: Invalid key";
 		return plainData;
 	}
 
-	int dataLength{plainData.size()};
-	int cipherLength{dataLength + AES_BLOCK_SIZE};
-	int finalLength{0};
-	uchar* cipherText{static_cast<uchar*>(malloc(cipherLength))};
+	// The cipher is set up only once, then only the key and the nonce are reset
+	const QByteArray nonce{createRandomData(GCM_NONCE_LENGTH)};
 
-	EVP_EncryptInit_ex(m_encodedCTX, nullptr, nullptr, nullptr, nullptr);
-	EVP_EncryptUpdate(m_encodedCTX, cipherText, &cipherLength, (uchar*) plainData.data(), dataLength);
-	EVP_EncryptFinal_ex(m_encodedCTX, cipherText + cipherLength, &finalLength);
+	if (EVP_EncryptInit_ex(m_encodedCTX,
+						   m_encodedCTXReady ? nullptr : EVP_aes_256_gcm(),
+						   nullptr,
+						   key.key.constData(),
+						   (uchar*) nonce.constData()) != 1) {
+		qWarning() << "EVP is not initialized";
+		m_encodedCTXReady = false;
+		return plainData;
+	}
 
-	dataLength = cipherLength + finalLength;
+	m_encodedCTXReady = true;
 
-	QByteArray out{(char*) cipherText, dataLength};
-	out = QByteArray::number(AesInterface::VERSION) + '$' + m_iVector.toBase64() + '$' + out.toBase64();
+	int cipherLength{0};
+	int finalLength{0};
+	QByteArray cipherText(plainData.size() + AES_BLOCK_SIZE, Qt::Uninitialized);
+	QByteArray tag(GCM_TAG_LENGTH, Qt::Uninitialized);
 
-	free(cipherText);
+	EVP_EncryptUpdate(m_encodedCTX, (uchar*) cipherText.data(), &cipherLength, (uchar*) plainData.constData(),
+					  plainData.size());
+	EVP_EncryptFinal_ex(m_encodedCTX, (uchar*) cipherText.data() + cipherLength, &finalLength);
+
+	if (EVP_CIPHER_CTX_ctrl(m_encodedCTX, EVP_CTRL_GCM_GET_TAG, GCM_TAG_LENGTH, tag.data()) != 1) {
+		qWarning() << "Encrypt error: Can't get authentication tag";
+		return plainData;
+	}
+
+	cipherText.resize(cipherLength + finalLength);
 
 	m_ok = true;
-	return out;
+	return QByteArray::number(2) + '$' + QByteArray::number(key.iterations) + '$' + key.salt.toBase64() + '$'
+		   + (nonce + cipherText + tag).toBase64();
 }
 
-QByteArray AesInterface::decrypt(const QByteArray& cipherData, const QByteArray& password)
+QByteArray AesInterface::decryptWithKey(const QByteArray& cipherData, const DerivedKey& key)
 {
 	m_ok = false;
 
@@ -103,26 +329,107 @@ QByteArray AesInterface::decrypt(const QByteArray& cipherData, const QByteArray&
 	}
 
 	QList<QByteArray> cipherSections(cipherData.split('$'));
+	const int version{cipherSections[0].toInt()};
+
+	if (version > AesInterface::VERSION) {
+		// Bulk decryption runs on worker threads where no dialog can be shown
+		if (QThread::currentThread() == qApp->thread()) {
+			QMessageBox::warning(nullptr,
+								 tr("Warning!"),
+								 tr("Datas have been encrypted with a newer version of Sielo. Please install the latest version!"));
+		}
+		else
+			qWarning() << "Decrypt error: Datas have been encrypted with a newer version of Sielo";
 
-	if (cipherSections.size() != 3) {
+		return QByteArray();
+	}
+
+	if (version == 1)
+		return decryptLegacy(cipherSections, key);
+
+	if (version != 2) {
+		qWarning() << "There is a version error for decoder";
+		return QByteArray();
+	}
+
+	if (cipherSections.size() != 4) {
 		qWarning() << "Decrypt error: It seems datas are corupted";
 		return QByteArray();
 	}
 
-	if (cipherSections[0].toInt() > AesInterface::VERSION) {
-		QMessageBox::warning(nullptr,
-							 tr("Warning!"),
-							 tr("Datas have been encrypted with a newer version of Sielo. Please install the latest version!"));
+	if (!key.isValid() || key.id() != keyId(cipherData)) {
+		qWarning() << "Decrypt error: The key doesn't match the datas";
 		return QByteArray();
 	}
 
-	if (cipherSections[0].toInt() != 1) {
-		qWarning() << "There is a version error for decoder";
+	const QByteArray payload{QByteArray::fromBase64(cipherSections[3])};
+
+	if (payload.size() < GCM_NONCE_LENGTH + GCM_TAG_LENGTH) {
+		qWarning() << "Decrypt error: It seems datas are corupted";
+		return QByteArray();
+	}
+
+	const QByteArray nonce{payload.left(GCM_NONCE_LENGTH)};
+	const QByteArray cipherText{payload.mid(GCM_NONCE_LENGTH, payload.size() - GCM_NONCE_LENGTH - GCM_TAG_LENGTH)};
+	QByteArray tag{payload.right(GCM_TAG_LENGTH)};
+
+	if (EVP_DecryptInit_ex(m_decodedCTX,
+						   m_decodedCTXReady ? nullptr : EVP_aes_256_gcm(),
+						   nullptr,
+						   key.key.constData(),
+						   (uchar*) nonce.constData()) != 1) {
+		qWarning() << "EVP is not initialized";
+		m_decodedCTXReady = false;
+		return QByteArray();
+	}
+
+	m_decodedCTXReady = true;
+
+	int plainTextLength{0};
+	int finalLength{0};
+	QByteArray plainText(cipherText.size() + AES_BLOCK_SIZE, Qt::Uninitialized);
+
+	EVP_DecryptUpdate(m_decodedCTX, (uchar*) plainText.data(), &plainTextLength, (uchar*) cipherText.constData(),
+					  cipherText.size());
+	EVP_CIPHER_CTX_ctrl(m_decodedCTX, EVP_CTRL_GCM_SET_TAG, GCM_TAG_LENGTH, tag.data());
+
+	// Fails if the datas or the tag have been altered
+	if (EVP_DecryptFinal_ex(m_decodedCTX, (uchar*) plainText.data() + plainTextLength, &finalLength) != 1) {
+		wipe(plainText);
 		return QByteArray();
 	}
 
-	if (!init(EVP_PKEY_MO_DECRYPT, password, QByteArray::fromBase64(cipherSections[1])))
+	plainText.resize(plainTextLength + finalLength);
+
+	m_ok = true;
+	return plainText;
+}
+
+QByteArray AesInterface::decryptLegacy(const QList<QByteArray>& cipherSections, const DerivedKey& key)
+{
+	if (cipherSections.size() != 3) {
+		qWarning() << "Decrypt error: It seems datas are corupted";
+		return QByteArray();
+	}
+
+	if (!key.isValid() || !key.isLegacy()) {
+		qWarning() << "Decrypt error: The key doesn't match the datas";
+		return QByteArray();
+	}
+
+	const QByteArray iVector{QByteArray::fromBase64(cipherSections[1])};
+
+	if (EVP_DecryptInit_ex(m_legacyDecodedCTX,
+						   m_legacyDecodedCTXReady ? nullptr : EVP_aes_256_cbc(),
+						   nullptr,
+						   key.key.constData(),
+						   (uchar*) iVector.constData()) != 1) {
+		qWarning() << "EVP is not initialized";
+		m_legacyDecodedCTXReady = false;
 		return QByteArray();
+	}
+
+	m_legacyDecodedCTXReady = true;
 
 	QByteArray cipherArray{QByteArray::fromBase64(cipherSections[2])};
 	int cipherLength{cipherArray.size()};
@@ -131,10 +438,9 @@ QByteArray AesInterface::decrypt(const QByteArray& cipherData, const QByteArray&
 	uchar* cipherText{(uchar*) cipherArray.data()};
 	uchar* plainText{static_cast<uchar*>(malloc(plainTextLength + AES_BLOCK_SIZE))};
 
-	EVP_DecryptInit_ex(m_decodedCTX, nullptr, nullptr, nullptr, nullptr);
-	EVP_DecryptUpdate(m_decodedCTX, plainText, &plainTextLength, cipherText, cipherLength);
+	EVP_DecryptUpdate(m_legacyDecodedCTX, plainText, &plainTextLength, cipherText, cipherLength);
 
-	int success{EVP_DecryptFinal_ex(m_decodedCTX, plainText + plainTextLength, &finalLength)};
+	int success{EVP_DecryptFinal_ex(m_legacyDecodedCTX, plainText + plainTextLength, &finalLength)};
 
 	cipherLength = plainTextLength + finalLength;
 
@@ -150,44 +456,4 @@ QByteArray AesInterface::decrypt(const QByteArray& cipherData, const QByteArray&
 
 }
 
-bool AesInterface::init(int evpMode, const QByteArray& password, const QByteArray& iVector)
-{
-	m_iVector.clear();
-
-	int i{};
-	const int nrounds{5};
-	uchar Key[EVP_MAX_KEY_LENGTH];
-
-	i = EVP_BytesToKey(EVP_aes_256_cbc(),
-					   EVP_sha256(),
-					   nullptr,
-					   (uchar*) password.data(),
-					   password.size(),
-					   nrounds,
-					   Key,
-					   nullptr);
-
-	if (i != 32) {
-		qWarning("Key size is %d bits - should be 256 bits", i * 8);
-		return false;
-	}
-
-	int result{0};
-
-	if (evpMode == EVP_PKEY_MO_ENCRYPT) {
-		m_iVector = createRandomData(EVP_MAX_IV_LENGTH);
-		result = EVP_EncryptInit_ex(m_encodedCTX, EVP_aes_256_cbc(), nullptr, Key, (uchar*) m_iVector.constData());
-	}
-	else if (evpMode == EVP_PKEY_MO_DECRYPT)
-		result = EVP_DecryptInit_ex(m_decodedCTX, EVP_aes_256_cbc(), nullptr, Key, (uchar*) iVector.constData());
-
-	if (result == 0) {
-		qWarning() << "EVP is not initialized";
-		return false;
-	}
-
-	return true;
-
-}
-
 }
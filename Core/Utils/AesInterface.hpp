@@ -34,32 +34,93 @@
 
 #include <QByteArray>
 
+#include <vector>
+
 namespace Sn {
 
+/*
+ * Data are stored as "version$..." strings:
+ *  - version 1: "1$iv$ciphertext", AES-256-CBC with a key from EVP_BytesToKey (read only)
+ *  - version 2: "2$iterations$salt$nonce|ciphertext|tag", AES-256-GCM with a PBKDF2-HMAC-SHA256 key
+ */
 class AesInterface: public QObject {
 Q_OBJECT
 
 public:
 	static const int VERSION;
+	static const int DEFAULT_KDF_ITERATIONS;
+	// Datas claiming an iteration count outside of these bounds are considered undecryptable
+	static const int MIN_KDF_ITERATIONS;
+	static const int MAX_KDF_ITERATIONS;
+
+	// Key bytes owned by a single buffer, so wiping it really erases them. It can be moved but never copied
+	class SecureKey {
+	public:
+		SecureKey() = default;
+		SecureKey(const uchar* data, int size);
+		SecureKey(SecureKey&& other) noexcept;
+		~SecureKey();
+
+		SecureKey(const SecureKey&) = delete;
+		SecureKey& operator=(const SecureKey&) = delete;
+		SecureKey& operator=(SecureKey&& other) noexcept;
+
+		const uchar* constData() const { return m_data.data(); }
+		int size() const { return static_cast<int>(m_data.size()); }
+
+		void wipe();
+
+	private:
+		std::vector<uchar> m_data{};
+	};
+
+	struct DerivedKey {
+		SecureKey key{};
+		QByteArray salt{};
+		int iterations{0};
+
+		bool isValid() const { return key.size() == 32; }
+		bool isLegacy() const { return iterations == 0; }
+		QByteArray id() const;
+		void wipe();
+	};
 
 	AesInterface(QObject* parent = nullptr);
 	~AesInterface();
 
 	bool isOk() const { return m_ok; }
 
+	// Derive the key from the password on each call, this is slow on purpose
 	QByteArray encrypt(const QByteArray& plainData, const QByteArray& password);
 	QByteArray decrypt(const QByteArray& cipherData, const QByteArray& password);
 
+	// Same as above with an already derived key. It must match the version and key id of the data to decrypt
+	QByteArray encryptWithKey(const QByteArray& plainData, const DerivedKey& key);
+	QByteArray decryptWithKey(const QByteArray& cipherData, const DerivedKey& key);
+
+	static DerivedKey deriveKey(const QByteArray& password, const QByteArray& salt = QByteArray(),
+								int iterations = DEFAULT_KDF_ITERATIONS);
+	static DerivedKey passwordToKey(const QByteArray& password);
+
+	static int dataVersion(const QByteArray& cipherData);
+	static QByteArray keyId(const QByteArray& cipherData);
+	static DerivedKey keyParameters(const QByteArray& cipherData);
+
 	static QByteArray createRandomData(int length);
+	static void wipe(QByteArray& data);
 
 private:
-	bool init(int evpMode, const QByteArray& password, const QByteArray& iVector = QByteArray());
+	QByteArray decryptLegacy(const QList<QByteArray>& cipherSections, const DerivedKey& key);
 
 	EVP_CIPHER_CTX* m_encodedCTX;
 	EVP_CIPHER_CTX* m_decodedCTX;
+	EVP_CIPHER_CTX* m_legacyDecodedCTX;
+
+	bool m_encodedCTXReady{false};
+	bool m_decodedCTXReady{false};
+	bool m_legacyDecodedCTXReady{false};
 
 	bool m_ok{false};
-	QByteArray m_iVector{};
 };
 
 }
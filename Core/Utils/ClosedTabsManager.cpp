@@ -24,6 +24,12 @@
 
 #include "Utils/ClosedTabsManager.hpp"
 
+#include <QFile>
+#include <QSaveFile>
+#include <QDataStream>
+
+#include <QSettings>
+
 #include <QWebEngineHistory>
 #include <QWebEngineSettings>
 
@@ -33,9 +39,40 @@
 
 namespace Sn {
 
+static const int CLOSED_TABS_VERSION = 1;
+
+bool ClosedTabsManager::s_persistentTabsTaken = false;
+
+QByteArray ClosedTabsManager::Tab::history() const
+{
+	return compressedHistory.isEmpty() ? QByteArray() : qUncompress(compressedHistory);
+}
+
+int ClosedTabsManager::Tab::byteSize() const
+{
+	return compressedHistory.size() + title.size() * int(sizeof(QChar)) + url.toEncoded().size();
+}
+
 ClosedTabsManager::ClosedTabsManager()
 {
-	// Empty
+	QSettings settings{};
+
+	settings.beginGroup("Web-Settings");
+
+	m_closedTabs.resize(qMax(1, settings.value("closedTabsMaxCount", 50).toInt()));
+	m_maximumBytes = qint64(qMax(1, settings.value("closedTabsMemoryBudget", 4096).toInt())) * 1024;
+	m_persistent = settings.value("saveClosedTabs", false).toBool();
+
+	settings.endGroup();
+
+	if (m_persistent && !Application::instance()->privateBrowsing())
+		loadClosedTabs();
+}
+
+ClosedTabsManager::~ClosedTabsManager()
+{
+	if (m_persistent && !Application::instance()->privateBrowsing())
+		saveClosedTabs();
 }
 
 void ClosedTabsManager::saveTab(WebTab* tab, int position)
@@ -43,7 +80,7 @@ void ClosedTabsManager::saveTab(WebTab* tab, int position)
 	if (Application::instance()->privateBrowsing())
 		return;
 
-	if (tab->url().isEmpty() && tab->history()->items().count() == 0)
+	if (tab->url().isEmpty() && (!tab->history() || tab->history()->items().count() == 0))
 		return;
 
 	Tab closedTab;
@@ -51,22 +88,22 @@ void ClosedTabsManager::saveTab(WebTab* tab, int position)
 	closedTab.title = tab->title();
 	closedTab.icon = tab->icon();
 	closedTab.position = position;
-	closedTab.history = tab->historyData();
+	closedTab.compressedHistory = qCompress(tab->historyData());
 	closedTab.zoomLevel = tab->zoomLevel();
 
-	m_closedTabs.prepend(closedTab);
-
+	prepend(closedTab);
 }
 
-ClosedTabsManager::Tab ClosedTabsManager::takeLastClosedTab()
+const ClosedTabsManager::Tab& ClosedTabsManager::tabAt(int index) const
 {
-	Tab tab;
-	tab.position = -1;
+	Q_ASSERT(index >= 0 && index < m_count);
 
-	if (m_closedTabs.count() > 0)
-		tab = m_closedTabs.takeFirst();
+	return m_closedTabs[slot(index)];
+}
 
-	return tab;
+ClosedTabsManager::Tab ClosedTabsManager::takeLastClosedTab()
+{
+	return takeTabAt(0);
 }
 
 ClosedTabsManager::Tab ClosedTabsManager::takeTabAt(int index)
@@ -74,23 +111,164 @@ ClosedTabsManager::Tab ClosedTabsManager::takeTabAt(int index)
 	Tab tab;
 	tab.position = -1;
 
-	QLinkedList<Tab>::iterator it;
-	int i = 0;
+	if (index < 0 || index >= m_count)
+		return tab;
 
-	for (it = m_closedTabs.begin(); it != m_closedTabs.end(); ++it, ++i) {
-		if (i == index) {
-			tab = *it;
-			m_closedTabs.erase(it);
-			break;
-		}
-	}
+	tab = m_closedTabs[slot(index)];
+
+	// Close the gap by moving the more recent tabs one slot back
+	for (int i{index}; i > 0; --i)
+		m_closedTabs[slot(i)] = m_closedTabs[slot(i - 1)];
+
+	m_closedTabs[m_head] = Tab();
+	m_head = (m_head + m_closedTabs.size() - 1) % m_closedTabs.size();
+	m_bytes -= tab.byteSize();
+	--m_count;
 
 	return tab;
 }
 
+QVector<ClosedTabsManager::Tab> ClosedTabsManager::allClosedTab() const
+{
+	QVector<Tab> tabs{};
+	tabs.reserve(m_count);
+
+	for (int i{0}; i < m_count; ++i)
+		tabs.append(m_closedTabs[slot(i)]);
+
+	return tabs;
+}
+
 void ClosedTabsManager::clearList()
 {
+	const int capacity{m_closedTabs.size()};
+
 	m_closedTabs.clear();
+	m_closedTabs.resize(capacity);
+	m_head = 0;
+	m_count = 0;
+	m_bytes = 0;
 }
 
-}
\ No newline at end of file
+int ClosedTabsManager::slot(int index) const
+{
+	return (m_head - index + m_closedTabs.size()) % m_closedTabs.size();
+}
+
+void ClosedTabsManager::prepend(const Tab& tab)
+{
+	// When the buffer is full the oldest tab is overwritten
+	if (m_count == m_closedTabs.size()) {
+		m_bytes -= m_closedTabs[slot(m_count - 1)].byteSize();
+		--m_count;
+	}
+
+	m_head = (m_head + 1) % m_closedTabs.size();
+	m_closedTabs[m_head] = tab;
+	m_bytes += tab.byteSize();
+	++m_count;
+
+	shrinkToBudget();
+}
+
+void ClosedTabsManager::shrinkToBudget()
+{
+	// Always keep the last closed tab, even if it is bigger than the budget
+	while (m_count > 1 && m_bytes > m_maximumBytes) {
+		const int oldest{slot(m_count - 1)};
+
+		m_bytes -= m_closedTabs[oldest].byteSize();
+		m_closedTabs[oldest] = Tab();
+		--m_count;
+	}
+}
+
+void ClosedTabsManager::loadClosedTabs()
+{
+	// Only the first tabs space of the session gets the tabs closed in the previous one
+	if (s_persistentTabsTaken)
+		return;
+
+	s_persistentTabsTaken = true;
+
+	const QString fileName{closedTabsFile()};
+	QVector<Tab> tabs{readClosedTabs(fileName)};
+
+	// The file is ordered from the last closed tab
+	for (int i{tabs.count() - 1}; i >= 0; --i) {
+		tabs[i].icon = Application::getAppIcon("webpage");
+		prepend(tabs[i]);
+	}
+
+	QFile::remove(fileName);
+}
+
+void ClosedTabsManager::saveClosedTabs()
+{
+	if (m_count == 0)
+		return;
+
+	// Keep what other tabs spaces already saved, after our own tabs
+	QVector<Tab> tabs{allClosedTab()};
+	tabs += readClosedTabs(closedTabsFile());
+
+	QSaveFile file{closedTabsFile()};
+
+	if (!file.open(QIODevice::WriteOnly))
+		return;
+
+	QDataStream stream{&file};
+	qint64 bytes{0};
+	int count{0};
+
+	while (count < tabs.count() && count < m_closedTabs.size() && bytes <= m_maximumBytes) {
+		bytes += tabs[count].byteSize();
+		++count;
+	}
+
+	stream << CLOSED_TABS_VERSION << count;
+
+	for (int i{0}; i < count; ++i)
+		stream << tabs[i].url << tabs[i].title << tabs[i].compressedHistory << tabs[i].position << tabs[i].zoomLevel;
+
+	file.commit();
+}
+
+QString ClosedTabsManager::closedTabsFile()
+{
+	return Application::instance()->paths()[Application::P_Data] + QLatin1String("/closedtabs.dat");
+}
+
+QVector<ClosedTabsManager::Tab> ClosedTabsManager::readClosedTabs(const QString& fileName)
+{
+	QVector<Tab> tabs{};
+	QFile file{fileName};
+
+	if (!file.open(QIODevice::ReadOnly))
+		return tabs;
+
+	QDataStream stream{&file};
+
+	int version{0};
+	int count{0};
+
+	stream >> version >> count;
+
+	if (version != CLOSED_TABS_VERSION || count < 0)
+		return tabs;
+
+	for (int i{0}; i < count; ++i) {
+		Tab tab{};
+
+		stream >> tab.url >> tab.title >> tab.compressedHistory >> tab.position >> tab.zoomLevel;
+
+		if (stream.status() != QDataStream::Ok)
+			break;
+
+		tabs.append(tab);
+	}
+
+	return tabs;
+}
+
+}
@@ -28,7 +28,7 @@
 
 #include <QUrl>
 #include <QIcon>
-#include <QLinkedList>
+#include <QVector>
 
 namespace Sn {
 class WebTab;
@@ -39,30 +39,56 @@ public:
 		QUrl url{};
 		QString title{};
 		QIcon icon{};
-		QByteArray history{};
+		QByteArray compressedHistory{};
 
 		int position{};
 		int zoomLevel{};
 
+		QByteArray history() const;
+		int byteSize() const;
+
 		bool operator==(const Tab& other) const
 		{
-			return (other.url == url && other.history == history && other.position == position);
+			return (other.url == url && other.compressedHistory == compressedHistory && other.position == position);
 		}
 	};
 
 	ClosedTabsManager();
+	~ClosedTabsManager();
 
 	void saveTab(WebTab* tab, int position);
-	bool isClosedTabAvailable() { return !m_closedTabs.isEmpty(); }
+	bool isClosedTabAvailable() const { return m_count > 0; }
+	int count() const { return m_count; }
 
+	// Index 0 is the last closed tab
+	const Tab& tabAt(int index) const;
 	Tab takeLastClosedTab();
 	Tab takeTabAt(int index);
 
-	QLinkedList<Tab> allClosedTab() { return m_closedTabs; }
+	QVector<Tab> allClosedTab() const;
 	void clearList();
 
 private:
-	QLinkedList<Tab> m_closedTabs;
+	int slot(int index) const;
+	void prepend(const Tab& tab);
+	void shrinkToBudget();
+
+	void loadClosedTabs();
+	void saveClosedTabs();
+
+	static QString closedTabsFile();
+	static QVector<Tab> readClosedTabs(const QString& fileName);
+
+	// Ring buffer, m_head is the slot of the last closed tab
+	QVector<Tab> m_closedTabs{};
+	int m_head{0};
+	int m_count{0};
+	qint64 m_bytes{0};
+
+	qint64 m_maximumBytes{0};
+	bool m_persistent{false};
+
+	static bool s_persistentTabsTaken;
 };
 }
 Q_DECLARE_TYPEINFO(Sn::ClosedTabsManager::Tab, Q_MOVABLE_TYPE);
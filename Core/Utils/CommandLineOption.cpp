@@ -66,6 +66,9 @@ void CommandLineOption::parseActions()
 	openWindowOption.setValueName(QStringLiteral("URL"));
 	openWindowOption.setDescription(QStringLiteral("Opens URL in new window."));
 
+	QCommandLineOption traceStartupOption{QStringLiteral("trace-startup")};
+	traceStartupOption.setDescription(QStringLiteral("Saves a Chrome trace of the startup phases in the profile directory."));
+
 	QCommandLineParser parser{};
 	parser.setApplicationDescription(QStringLiteral("A fast web browser in C++ with Qt"));
 
@@ -79,6 +82,7 @@ void CommandLineOption::parseActions()
 	parser.addOption(newWindowOption);
 	parser.addOption(currentTabOption);
 	parser.addOption(openWindowOption);
+	parser.addOption(traceStartupOption);
 
 	parser.addPositionalArgument(QStringLiteral("URL"), QStringLiteral("URLs to open"), QStringLiteral("[URL...]"));
 
@@ -110,6 +114,13 @@ void CommandLineOption::parseActions()
 		m_action.append(pair);
 	}
 
+	if (parser.isSet(traceStartupOption)) {
+		ActionPair pair;
+		pair.action = Application::CL_TraceStartup;
+
+		m_action.append(pair);
+	}
+
 	if (parser.isSet(newTabOption)) {
 		ActionPair pair;
 		pair.action = Application::CL_NewTab;
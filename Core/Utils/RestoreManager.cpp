@@ -24,15 +24,37 @@
 
 #include "Utils/RestoreManager.hpp"
 
+#include <QFile>
+#include <QDataStream>
+
+#include <QtConcurrent/QtConcurrentMap>
+
+#include <QDebug>
+
+#include <algorithm>
+#include <numeric>
 
 #include "Utils/RecoveryJsObject.hpp"
 
 #include "Web/WebPage.hpp"
 
+#include "Widgets/Tab/TabWidget.hpp"
+
 #include "Application.hpp"
+#include "BrowserWindow.hpp"
 
 namespace Sn {
 
+// Version 4 is a flat format: windows table, tabs spaces table, tabs offset table and tabs data
+static const int SESSION_VERSION = 0x0004;
+static const int PARALLEL_DECODE_THRESHOLD = 64;
+
+// Smallest encoding of each record of an indexed session: a window is three empty containers and an int,
+// a space a null url and three ints, a tab its offset and size
+static const qint64 MIN_WINDOW_RECORD_SIZE = 16;
+static const qint64 MIN_SPACE_RECORD_SIZE = 16;
+static const qint64 MIN_TAB_RECORD_SIZE = 8;
+
 RestoreManager::RestoreManager() :
 	m_recoveryObject(new RecoveryJsObject(this))
 {
@@ -43,6 +65,12 @@ RestoreManager::RestoreManager() :
 
 }
 
+RestoreManager::RestoreManager(const QByteArray& sessionData) :
+	m_recoveryObject(new RecoveryJsObject(this))
+{
+	createFromData(sessionData);
+}
+
 RestoreManager::~RestoreManager()
 {
 	delete m_recoveryObject;
@@ -64,6 +92,63 @@ QObject* RestoreManager::recoveryObject(WebPage* page)
 	return m_recoveryObject;
 }
 
+QByteArray RestoreManager::serialize(const QList<BrowserWindow*>& windows)
+{
+	QByteArray windowsData{};
+	QByteArray spacesData{};
+	QByteArray tabsIndex{};
+	QByteArray tabsData{};
+	QDataStream windowsStream{&windowsData, QIODevice::WriteOnly};
+	QDataStream spacesStream{&spacesData, QIODevice::WriteOnly};
+	QDataStream indexStream{&tabsIndex, QIODevice::WriteOnly};
+
+	int spaceCount{0};
+	int tabCount{0};
+
+	foreach (BrowserWindow* window, windows) {
+		// Save state of window (is it's in full screen)
+		windowsStream << (window->isFullScreen() ? QByteArray() : window->saveState());
+		windowsStream << window->saveGeometry();
+		windowsStream << window->tabsSpacesLayout();
+		windowsStream << spaceCount;
+
+		foreach (TabWidget* tabWidget, window->tabsSpacesInLayoutOrder()) {
+			QList<WebTab*> tabs{tabWidget->allTabs()};
+
+			spacesStream << tabWidget->homeUrl();
+			spacesStream << tabWidget->currentIndex();
+			spacesStream << tabCount;
+			spacesStream << tabs.count();
+
+			// Tabs keep their serialized state until it changes
+			foreach (WebTab* tab, tabs) {
+				const QByteArray tabData{tab->sessionData()};
+
+				indexStream << quint32(tabsData.size()) << quint32(tabData.size());
+				tabsData.append(tabData);
+			}
+
+			++spaceCount;
+			tabCount += tabs.count();
+		}
+	}
+
+	QByteArray data{};
+	QDataStream stream{&data, QIODevice::WriteOnly};
+
+	stream << SESSION_VERSION;
+	stream << windows.count();
+	stream << spaceCount;
+	stream << tabCount;
+
+	stream.writeRawData(windowsData.constData(), windowsData.size());
+	stream.writeRawData(spacesData.constData(), spacesData.size());
+	stream.writeRawData(tabsIndex.constData(), tabsIndex.size());
+	stream.writeRawData(tabsData.constData(), tabsData.size());
+
+	return data;
+}
+
 void RestoreManager::createFromFile(const QString& file)
 {
 	if (!QFile::exists(file))
@@ -71,16 +156,164 @@ void RestoreManager::createFromFile(const QString& file)
 
 	QFile recoveryFile{file};
 
-	recoveryFile.open(QIODevice::ReadOnly);
+	if (!recoveryFile.open(QIODevice::ReadOnly))
+		return;
 
-	QDataStream stream{&recoveryFile};
+	// Tabs are decoded straight from the mapped file, without copying it first
+	const uchar* mappedFile{recoveryFile.map(0, recoveryFile.size())};
+	const QByteArray data{mappedFile
+		? QByteArray::fromRawData(reinterpret_cast<const char*>(mappedFile), static_cast<int>(recoveryFile.size()))
+		: recoveryFile.readAll()};
+
+	createFromData(data);
+
+	if (!isValid())
+		qWarning() << "RestoreManager: nothing to restore from" << file;
+}
+
+void RestoreManager::createFromData(const QByteArray& data)
+{
+	QDataStream stream{data};
 
 	int version{0};
 	stream >> version;
 
-	if (version > 0x0003)
+	if (version > SESSION_VERSION)
 		return;
 
+	if (version >= 0x0004) {
+		if (!createFromIndexedData(stream, data)) {
+			qWarning() << "RestoreManager: session data is corrupted";
+			m_data.clear();
+		}
+	}
+	else {
+		createFromLegacyData(stream, version);
+	}
+}
+
+bool RestoreManager::createFromIndexedData(QDataStream& stream, const QByteArray& data)
+{
+	struct WindowRecord {
+		QByteArray state{};
+		QByteArray geometry{};
+		QVector<int> layout{};
+		int firstSpace{0};
+	};
+
+	struct SpaceRecord {
+		QUrl homeUrl{};
+		int currentTab{0};
+		int firstTab{0};
+		int tabCount{0};
+	};
+
+	int windowCount{0};
+	int spaceCount{0};
+	int tabCount{0};
+
+	stream >> windowCount >> spaceCount >> tabCount;
+
+	if (windowCount < 0 || spaceCount < 0 || tabCount < 0)
+		return false;
+
+	// Counts that can't fit in the rest of the data are rejected before anything is allocated for them
+	const qint64 remaining{data.size() - stream.device()->pos()};
+
+	if (windowCount * MIN_WINDOW_RECORD_SIZE + spaceCount * MIN_SPACE_RECORD_SIZE + tabCount * MIN_TAB_RECORD_SIZE > remaining)
+		return false;
+
+	QVector<WindowRecord> windows(windowCount);
+	QVector<SpaceRecord> spaces(spaceCount);
+	QVector<quint32> offsets(tabCount);
+	QVector<quint32> sizes(tabCount);
+
+	for (WindowRecord& window : windows)
+		stream >> window.state >> window.geometry >> window.layout >> window.firstSpace;
+
+	for (SpaceRecord& space : spaces)
+		stream >> space.homeUrl >> space.currentTab >> space.firstTab >> space.tabCount;
+
+	for (int i{0}; i < tabCount; ++i)
+		stream >> offsets[i] >> sizes[i];
+
+	if (stream.status() != QDataStream::Ok)
+		return false;
+
+	const qint64 tabsStart{stream.device()->pos()};
+	const qint64 tabsSize{data.size() - tabsStart};
+
+	for (int i{0}; i < tabCount; ++i) {
+		if (qint64(offsets[i]) + sizes[i] > tabsSize)
+			return false;
+	}
+
+	// Tab records are independent from each other, big sessions are decoded in parallel
+	QVector<WebTab::SavedTab> tabs(tabCount);
+	QVector<int> tabIndexes(tabCount);
+
+	std::iota(tabIndexes.begin(), tabIndexes.end(), 0);
+
+	auto decodeTab = [&](int index)
+	{
+		QDataStream tabStream{QByteArray::fromRawData(data.constData() + tabsStart + offsets[index],
+													  static_cast<int>(sizes[index]))};
+		tabStream >> tabs[index];
+	};
+
+	if (tabCount >= PARALLEL_DECODE_THRESHOLD)
+		QtConcurrent::blockingMap(tabIndexes, decodeTab);
+	else
+		std::for_each(tabIndexes.begin(), tabIndexes.end(), decodeTab);
+
+	foreach (const WindowRecord& window, windows) {
+		WindowData windowData{};
+
+		windowData.windowState = window.state;
+		windowData.windowGeometry = window.geometry;
+		windowData.spaceTabsCount = window.layout;
+
+		if (window.layout.isEmpty())
+			continue;
+
+		// BrowserWindow::restoreWindowState() trusts the layout: the column count, then the spaces of each
+		// column, the first one holding at least the main tabs space
+		if (window.layout[0] != window.layout.size() - 1 || window.layout.size() < 2 || window.layout[1] < 1)
+			return false;
+
+		qint64 windowSpaces{0};
+
+		for (int i{1}; i < window.layout.size(); ++i) {
+			if (window.layout[i] < 0)
+				return false;
+
+			windowSpaces += window.layout[i];
+		}
+
+		if (window.firstSpace < 0 || window.firstSpace + windowSpaces > spaceCount)
+			return false;
+
+		const int lastSpace{window.firstSpace + static_cast<int>(windowSpaces)};
+
+		for (int i{window.firstSpace}; i < lastSpace; ++i) {
+			const SpaceRecord& space{spaces[i]};
+
+			if (space.firstTab < 0 || space.tabCount < 0 || space.firstTab + space.tabCount > tabCount)
+				return false;
+
+			windowData.homeUrls.append(space.homeUrl);
+			windowData.currentTabs.append(space.currentTab);
+			windowData.tabsState.append(tabs.mid(space.firstTab, space.tabCount));
+		}
+
+		m_data.append(windowData);
+	}
+
+	return true;
+}
+
+void RestoreManager::createFromLegacyData(QDataStream& stream, int version)
+{
 	int windowCount{};
 	stream >> windowCount;
 
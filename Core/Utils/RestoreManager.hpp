@@ -32,8 +32,11 @@
 
 #include "Web/Tab/WebTab.hpp"
 
+class QDataStream;
+
 namespace Sn {
 class WebPage;
+class BrowserWindow;
 class RecoveryJsObject;
 
 class RestoreManager {
@@ -48,6 +51,7 @@ public:
 	};
 
 	RestoreManager();
+	RestoreManager(const QByteArray& sessionData);
 	virtual ~RestoreManager();
 
 	bool isValid() const;
@@ -55,8 +59,13 @@ public:
 
 	QObject* recoveryObject(WebPage* page);
 
+	static QByteArray serialize(const QList<BrowserWindow*>& windows);
+
 private:
 	void createFromFile(const QString& file);
+	void createFromData(const QByteArray& data);
+	bool createFromIndexedData(QDataStream& stream, const QByteArray& data);
+	void createFromLegacyData(QDataStream& stream, int version);
 
 	RecoveryJsObject* m_recoveryObject{nullptr};
 	QVector<RestoreManager::WindowData> m_data;
@@ -0,0 +1,110 @@
+/***********************************************************************************
+** MIT License                                                                    **
+**                                                                                **
+** Copyright (c) 2018 Victor DENIS (victordenis01@gmail.com)                      **
+**                                                                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+***********************************************************************************/
+
+#include "Utils/SettingsCache.hpp"
+
+#include <QSettings>
+
+#include "Web/WebView.hpp"
+
+namespace Sn {
+
+Q_GLOBAL_STATIC(SettingsCache, sn_settings_cache)
+
+SettingsCache::SettingsCache(QObject* parent) :
+	QObject(parent)
+{
+	reload();
+}
+
+SettingsCache::~SettingsCache()
+{
+	// Empty
+}
+
+int SettingsCache::defaultZoomLevel() const
+{
+	QReadLocker locker{&m_lock};
+	return m_defaultZoomLevel;
+}
+
+bool SettingsCache::sendDoNotTrack() const
+{
+	QReadLocker locker{&m_lock};
+	return m_sendDoNotTrack;
+}
+
+bool SettingsCache::upgradeToHttps() const
+{
+	QReadLocker locker{&m_lock};
+	return m_upgradeToHttps;
+}
+
+SettingsCache::CookiePolicy SettingsCache::cookiePolicy() const
+{
+	QReadLocker locker{&m_lock};
+	return m_cookiePolicy;
+}
+
+SettingsCache* SettingsCache::instance()
+{
+	return sn_settings_cache();
+}
+
+void SettingsCache::reload()
+{
+	QSettings settings{};
+	CookiePolicy cookiePolicy{};
+
+	settings.beginGroup("Web-Settings");
+
+	const int defaultZoomLevel{settings.value("defaultZoomLevel", WebView::zoomLevels().indexOf(100)).toInt()};
+	const bool sendDoNotTrack{settings.value("DoNotTrack", false).toBool()};
+	const bool upgradeToHttps{settings.value("upgradeToHttps", true).toBool()};
+
+	settings.endGroup();
+
+	settings.beginGroup("Cookie-Settings");
+
+	cookiePolicy.allowCookies = settings.value("allowCookies", true).toBool();
+	cookiePolicy.filterThirdParty = settings.value("filterThirdPartyCookies", false).toBool();
+	cookiePolicy.filterTrackingCookies = settings.value("filterTrackingCookies", false).toBool();
+	cookiePolicy.whiteList = settings.value("whiteList", QStringList()).toStringList();
+	cookiePolicy.blackList = settings.value("blackList", QStringList()).toStringList();
+
+	settings.endGroup();
+
+	{
+		QWriteLocker locker{&m_lock};
+
+		m_defaultZoomLevel = defaultZoomLevel;
+		m_sendDoNotTrack = sendDoNotTrack;
+		m_upgradeToHttps = upgradeToHttps;
+		m_cookiePolicy = cookiePolicy;
+	}
+
+	emit changed();
+}
+
+}
@@ -0,0 +1,75 @@
+/***********************************************************************************
+** MIT License                                                                    **
+**                                                                                **
+** Copyright (c) 2018 Victor DENIS (victordenis01@gmail.com)                      **
+**                                                                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+***********************************************************************************/
+
+#pragma once
+#ifndef SIELOBROWSER_SETTINGSCACHE_HPP
+#define SIELOBROWSER_SETTINGSCACHE_HPP
+
+#include <QObject>
+#include <QReadWriteLock>
+
+#include <QStringList>
+
+namespace Sn {
+
+/* Hot settings read once from QSettings and shared by the whole process */
+class SettingsCache: public QObject {
+Q_OBJECT
+
+public:
+	struct CookiePolicy {
+		bool allowCookies{true};
+		bool filterThirdParty{false};
+		bool filterTrackingCookies{false};
+		QStringList whiteList{};
+		QStringList blackList{};
+	};
+
+	SettingsCache(QObject* parent = nullptr);
+	~SettingsCache();
+
+	int defaultZoomLevel() const;
+	bool sendDoNotTrack() const;
+	bool upgradeToHttps() const;
+	CookiePolicy cookiePolicy() const;
+
+	static SettingsCache* instance();
+
+signals:
+	void changed();
+
+public slots:
+	void reload();
+
+private:
+	mutable QReadWriteLock m_lock{};
+
+	int m_defaultZoomLevel{0};
+	bool m_sendDoNotTrack{false};
+	bool m_upgradeToHttps{true};
+	CookiePolicy m_cookiePolicy{};
+};
+}
+
+#endif //SIELOBROWSER_SETTINGSCACHE_HPP
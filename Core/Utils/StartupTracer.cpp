@@ -0,0 +1,230 @@
+/***********************************************************************************
+** MIT License                                                                    **
+**                                                                                **
+** Copyright (c) 2018 Victor DENIS (victordenis01@gmail.com)                      **
+**                                                                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+***********************************************************************************/
+
+#include "Utils/StartupTracer.hpp"
+
+#include <QCoreApplication>
+#include <QThread>
+
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QVector>
+#include <QPair>
+
+#include <QSaveFile>
+
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QJsonArray>
+
+#include <QDebug>
+
+#include <iostream>
+
+#include "Application.hpp"
+
+namespace Sn {
+
+struct StartupTrace {
+	struct Event {
+		const char* name{nullptr};
+		char phase{'X'};
+		qint64 timestamp{0};
+		qint64 duration{0};
+		quintptr thread{0};
+	};
+
+	QMutex mutex{};
+	QElapsedTimer clock{};
+	QVector<Event> events{};
+	QVector<QPair<const char*, qint64>> openPhases{};
+	bool enabled{false};
+	bool finished{false};
+};
+
+Q_GLOBAL_STATIC(StartupTrace, sn_startup_trace)
+
+StartupTracer::Phase::Phase(const char* name) :
+	m_name(name),
+	m_start(StartupTracer::elapsed())
+{
+	// Empty
+}
+
+StartupTracer::Phase::~Phase()
+{
+	addEvent(m_name, 'X', m_start, StartupTracer::elapsed() - m_start);
+}
+
+void StartupTracer::start()
+{
+	QMutexLocker locker{&sn_startup_trace()->mutex};
+
+	if (!sn_startup_trace()->clock.isValid())
+		sn_startup_trace()->clock.start();
+}
+
+void StartupTracer::setEnabled(bool enabled)
+{
+	QMutexLocker locker{&sn_startup_trace()->mutex};
+
+	sn_startup_trace()->enabled = enabled;
+}
+
+bool StartupTracer::isEnabled()
+{
+	QMutexLocker locker{&sn_startup_trace()->mutex};
+
+	return sn_startup_trace()->enabled;
+}
+
+void StartupTracer::begin(const char* name)
+{
+	const qint64 timestamp{elapsed()};
+	QMutexLocker locker{&sn_startup_trace()->mutex};
+
+	sn_startup_trace()->openPhases.append(qMakePair(name, timestamp));
+}
+
+void StartupTracer::end()
+{
+	const qint64 timestamp{elapsed()};
+	QPair<const char*, qint64> phase{};
+
+	{
+		QMutexLocker locker{&sn_startup_trace()->mutex};
+
+		if (sn_startup_trace()->openPhases.isEmpty()) {
+			qWarning() << "StartupTracer: end() called without begin()";
+			return;
+		}
+
+		phase = sn_startup_trace()->openPhases.takeLast();
+	}
+
+	addEvent(phase.first, 'X', phase.second, timestamp - phase.second);
+}
+
+void StartupTracer::mark(const char* name)
+{
+	addEvent(name, 'i', elapsed(), 0);
+}
+
+void StartupTracer::finish()
+{
+	mark("startupFinished");
+
+	QByteArray trace{};
+
+	{
+		QMutexLocker locker{&sn_startup_trace()->mutex};
+
+		if (sn_startup_trace()->finished)
+			return;
+
+		sn_startup_trace()->finished = true;
+
+		if (!sn_startup_trace()->enabled)
+			return;
+	}
+
+	const QString fileName{traceFilePath()};
+	QSaveFile file{fileName};
+
+	if (!file.open(QIODevice::WriteOnly)) {
+		qWarning() << "StartupTracer: can't open " << fileName;
+		return;
+	}
+
+	file.write(toJson());
+
+	if (!file.commit()) {
+		qWarning() << "StartupTracer: can't write " << fileName;
+		return;
+	}
+
+	std::cout << "Startup trace written to " << fileName.toStdString() << std::endl;
+}
+
+qint64 StartupTracer::elapsed()
+{
+	// QElapsedTimer is monotonic, nanoseconds are kept to have microseconds timestamps in the trace
+	return sn_startup_trace()->clock.isValid() ? sn_startup_trace()->clock.nsecsElapsed() / 1000 : 0;
+}
+
+QByteArray StartupTracer::toJson()
+{
+	QJsonArray traceEvents{};
+	const qint64 pid{QCoreApplication::applicationPid()};
+
+	QMutexLocker locker{&sn_startup_trace()->mutex};
+
+	foreach (const StartupTrace::Event& event, sn_startup_trace()->events) {
+		QJsonObject traceEvent{};
+
+		traceEvent.insert(QStringLiteral("name"), QString::fromLatin1(event.name));
+		traceEvent.insert(QStringLiteral("cat"), QStringLiteral("startup"));
+		traceEvent.insert(QStringLiteral("ph"), QString(QLatin1Char(event.phase)));
+		traceEvent.insert(QStringLiteral("ts"), event.timestamp);
+		traceEvent.insert(QStringLiteral("pid"), pid);
+		traceEvent.insert(QStringLiteral("tid"), static_cast<qint64>(event.thread));
+
+		if (event.phase == 'X')
+			traceEvent.insert(QStringLiteral("dur"), event.duration);
+		else
+			traceEvent.insert(QStringLiteral("s"), QStringLiteral("p"));
+
+		traceEvents.append(traceEvent);
+	}
+
+	QJsonObject trace{};
+
+	trace.insert(QStringLiteral("traceEvents"), traceEvents);
+	trace.insert(QStringLiteral("displayTimeUnit"), QStringLiteral("ms"));
+
+	return QJsonDocument(trace).toJson(QJsonDocument::Indented);
+}
+
+QString StartupTracer::traceFilePath()
+{
+	return Application::paths()[Application::P_Data] + QLatin1String("/startup-trace.json");
+}
+
+void StartupTracer::addEvent(const char* name, char phase, qint64 timestamp, qint64 duration)
+{
+	StartupTrace::Event event{};
+
+	event.name = name;
+	event.phase = phase;
+	event.timestamp = timestamp;
+	event.duration = duration;
+	event.thread = reinterpret_cast<quintptr>(QThread::currentThreadId());
+
+	QMutexLocker locker{&sn_startup_trace()->mutex};
+
+	if (!sn_startup_trace()->finished)
+		sn_startup_trace()->events.append(event);
+}
+
+}
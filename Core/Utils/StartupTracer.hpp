@@ -0,0 +1,74 @@
+/***********************************************************************************
+** MIT License                                                                    **
+**                                                                                **
+** Copyright (c) 2018 Victor DENIS (victordenis01@gmail.com)                      **
+**                                                                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+***********************************************************************************/
+
+#pragma once
+#ifndef SIELOBROWSER_STARTUPTRACER_HPP
+#define SIELOBROWSER_STARTUPTRACER_HPP
+
+#include <QByteArray>
+#include <QString>
+
+namespace Sn {
+
+/*
+ * Record named startup phases against a monotonic clock started in main().
+ * Phases are always recorded (they are a handful), they are only written to disk, in the Chrome trace
+ * format (chrome://tracing, Perfetto), when Sielo is started with "--trace-startup".
+ * Phase names are not copied, only string literals should be given
+ */
+class Q_DECL_EXPORT StartupTracer {
+public:
+	// Scoped phase, ended when it goes out of scope
+	class Phase {
+	public:
+		Phase(const char* name);
+		~Phase();
+
+	private:
+		const char* m_name{nullptr};
+		qint64 m_start{0};
+	};
+
+	static void start();
+
+	static void setEnabled(bool enabled);
+	static bool isEnabled();
+
+	static void begin(const char* name);
+	static void end();
+	static void mark(const char* name);
+
+	// Save the trace if tracing is enabled, later phases are not recorded anymore
+	static void finish();
+
+	static qint64 elapsed();
+	static QByteArray toJson();
+	static QString traceFilePath();
+
+private:
+	static void addEvent(const char* name, char phase, qint64 timestamp, qint64 duration);
+};
+}
+
+#endif //SIELOBROWSER_STARTUPTRACER_HPP
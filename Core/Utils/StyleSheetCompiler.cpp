@@ -0,0 +1,352 @@
+/***********************************************************************************
+** MIT License                                                                    **
+**                                                                                **
+** Copyright (c) 2018 Victor DENIS (victordenis01@gmail.com)                      **
+**                                                                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+***********************************************************************************/
+
+#include "Utils/StyleSheetCompiler.hpp"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QDir>
+#include <QDateTime>
+#include <QCryptographicHash>
+
+#include <QDebug>
+
+#include "Application.hpp"
+
+#include "Utils/ThemeArchive.hpp"
+
+#include "Widgets/Preferences/Appearance.hpp"
+
+namespace Sn {
+
+// Increase it each time the compiler output or the cache format change, to invalidate compiled style sheets
+static const int COMPILER_VERSION = 2;
+
+static const char* const COLOR_NAMES[] = {"main", "second", "accent", "text"};
+static const char* const COLOR_VARIANTS[] = {"normal", "light", "dark"};
+
+static bool matchAt(const QString& sss, int pos, QLatin1String token)
+{
+	return sss.midRef(pos, token.size()) == token;
+}
+
+static int skipSpaces(const QString& sss, int pos)
+{
+	while (pos < sss.size() && sss.at(pos).isSpace())
+		++pos;
+
+	return pos;
+}
+
+static bool isUrlDelimiter(QChar c)
+{
+	return c == QLatin1Char('*') || c == QLatin1Char(':') || c == QLatin1Char(')') || c == QLatin1Char(';');
+}
+
+static QString colorId(const char* name, const char* variant)
+{
+	return QString::fromLatin1(name) + QLatin1String(variant);
+}
+
+// Match one of the given words at pos, and move pos after it
+static const char* matchWord(const QString& sss, int& pos, const char* const* words, int count)
+{
+	for (int i{0}; i < count; ++i) {
+		const QLatin1String word{words[i]};
+
+		if (matchAt(sss, pos, word)) {
+			pos += word.size();
+			return words[i];
+		}
+	}
+
+	return nullptr;
+}
+
+StyleSheetCompiler::StyleSheetCompiler(const QString& relativePath, const QString& lightness) :
+	m_relativePath(relativePath),
+	m_lightness(lightness)
+{
+	for (const char* name : COLOR_NAMES) {
+		for (const char* variant : COLOR_VARIANTS) {
+			const QString id{colorId(name, variant)};
+			m_colors.insert(id, AppearancePage::colorString(id));
+		}
+	}
+}
+
+QString StyleSheetCompiler::compile(const QString& sss) const
+{
+	QString result{};
+	result.reserve(sss.size() + sss.size() / 4);
+
+	m_urls.clear();
+
+	int pos{0};
+
+	while (pos < sss.size()) {
+		const QChar c{sss.at(pos)};
+
+		if (c == QLatin1Char('u') && parseUrl(sss, pos, result))
+			continue;
+
+		if (c == QLatin1Char('s')) {
+			// Replace some Sielo API properties to Qt properties
+			if (matchAt(sss, pos, QLatin1String("sproperty"))) {
+				result += QLatin1String("qproperty");
+				pos += 9;
+				continue;
+			}
+
+			if (matchAt(sss, pos, QLatin1String("slineargradient"))) {
+				result += QLatin1String("qlineargradient");
+				pos += 15;
+				continue;
+			}
+
+			if (parseColorFunction(sss, pos, result))
+				continue;
+		}
+
+		if (c == QLatin1Char('$') && parseVariable(sss, pos, result))
+			continue;
+
+		result += c;
+		++pos;
+	}
+
+	return result;
+}
+
+QString StyleSheetCompiler::compileFiles(const QString& cacheName, const QStringList& files,
+										 const ThemeArchive* archive) const
+{
+	const QByteArray key{cacheKey(files, archive)};
+	const QString cacheFileName{cacheDirectory() + QLatin1Char('/') + cacheName + QLatin1String(".qss")};
+
+	QFile cacheFile{cacheFileName};
+
+	// Cache files are the key, the url() paths separated by ';' (which can't be part of a path) and the style sheet
+	if (cacheFile.open(QIODevice::ReadOnly)) {
+		if (cacheFile.readLine().trimmed() == key) {
+			m_urls = QString::fromUtf8(cacheFile.readLine().trimmed()).split(QLatin1Char(';'), QString::SkipEmptyParts);
+			return QString::fromUtf8(cacheFile.readAll());
+		}
+
+		cacheFile.close();
+	}
+
+	QString sss{};
+
+	foreach (const QString& file, files)
+		sss.append(QString::fromUtf8(archive ? archive->read(file) : Application::readAllFileByteContents(file)));
+
+	const QString compiled{compile(sss)};
+
+	QDir().mkpath(cacheDirectory());
+
+	QSaveFile saveFile{cacheFileName};
+
+	if (saveFile.open(QIODevice::WriteOnly)) {
+		saveFile.write(key + '\n');
+		saveFile.write(m_urls.join(QLatin1Char(';')).toUtf8() + '\n');
+		saveFile.write(compiled.toUtf8());
+
+		if (!saveFile.commit())
+			qWarning() << "StyleSheetCompiler: can't write compiled style sheet" << cacheFileName;
+	}
+
+	return compiled;
+}
+
+QString StyleSheetCompiler::cacheDirectory()
+{
+	return Application::paths()[Application::P_Data] + QLatin1String("/cache/stylesheets");
+}
+
+bool StyleSheetCompiler::parseUrl(const QString& sss, int& pos, QString& result) const
+{
+	// url(path) -> url(relativePath/path), path can't contain '*', ':', ')' or ';'
+	if (!matchAt(sss, pos, QLatin1String("url")))
+		return false;
+
+	int i{skipSpaces(sss, pos + 3)};
+
+	if (i >= sss.size() || sss.at(i) != QLatin1Char('('))
+		return false;
+
+	i = skipSpaces(sss, i + 1);
+
+	const int start{i};
+
+	while (i < sss.size() && !isUrlDelimiter(sss.at(i)))
+		++i;
+
+	if (i == start || i >= sss.size() || sss.at(i) != QLatin1Char(')'))
+		return false;
+
+	// Paths may depend on variables like $ulightness
+	QString path{};
+
+	for (int j{start}; j < i;) {
+		if (sss.at(j) == QLatin1Char('$') && parseVariable(sss, j, path))
+			continue;
+
+		path += sss.at(j);
+		++j;
+	}
+
+	result += QLatin1String("url(") + m_relativePath + QLatin1Char('/') + path + QLatin1Char(')');
+	m_urls.append(path.trimmed());
+
+	pos = i + 1;
+
+	return true;
+}
+
+bool StyleSheetCompiler::parseColorFunction(const QString& sss, int& pos, QString& result) const
+{
+	// scolor(name), scolor(name, variant) or scolor(name, variant, alpha) -> rgba(r, g, b, alpha)
+	if (!matchAt(sss, pos, QLatin1String("scolor")))
+		return false;
+
+	int i{skipSpaces(sss, pos + 6)};
+
+	if (i >= sss.size() || sss.at(i) != QLatin1Char('('))
+		return false;
+
+	i = skipSpaces(sss, i + 1);
+
+	const char* name{matchWord(sss, i, COLOR_NAMES, 4)};
+	const char* variant{COLOR_VARIANTS[0]};
+	QString alpha{QStringLiteral("255")};
+
+	if (!name)
+		return false;
+
+	i = skipSpaces(sss, i);
+
+	if (i < sss.size() && sss.at(i) == QLatin1Char(',')) {
+		i = skipSpaces(sss, i + 1);
+		variant = matchWord(sss, i, COLOR_VARIANTS, 3);
+
+		if (!variant)
+			return false;
+
+		i = skipSpaces(sss, i);
+
+		if (i < sss.size() && sss.at(i) == QLatin1Char(',')) {
+			i = skipSpaces(sss, i + 1);
+
+			const int start{i};
+
+			while (i < sss.size() && i - start < 3 && sss.at(i).isDigit())
+				++i;
+
+			if (i == start || sss.midRef(start, i - start).toInt() > 255)
+				return false;
+
+			alpha = sss.mid(start, i - start);
+			i = skipSpaces(sss, i);
+		}
+	}
+
+	if (i >= sss.size() || sss.at(i) != QLatin1Char(')'))
+		return false;
+
+	result += QLatin1String("rgba(") + m_colors.value(colorId(name, variant))
+		+ QLatin1String(", ") + alpha + QLatin1Char(')');
+	pos = i + 1;
+
+	return true;
+}
+
+bool StyleSheetCompiler::parseVariable(const QString& sss, int& pos, QString& result) const
+{
+	if (matchAt(sss, pos, QLatin1String("$ulightness"))) {
+		result += m_lightness;
+		pos += 11;
+		return true;
+	}
+
+	if (!matchAt(sss, pos, QLatin1String("$color")))
+		return false;
+
+	int i{pos + 6};
+	const char* name{matchWord(sss, i, COLOR_NAMES, 4)};
+	const char* variant{name ? matchWord(sss, i, COLOR_VARIANTS, 3) : nullptr};
+
+	if (!variant)
+		return false;
+
+	result += m_colors.value(colorId(name, variant));
+	pos = i;
+
+	return true;
+}
+
+QByteArray StyleSheetCompiler::cacheKey(const QStringList& files, const ThemeArchive* archive) const
+{
+	QCryptographicHash hash{QCryptographicHash::Sha1};
+
+	hash.addData(QByteArray::number(COMPILER_VERSION));
+	hash.addData(m_relativePath.toUtf8());
+	hash.addData(m_lightness.toUtf8());
+
+	// Files from an archive change with the archive itself
+	if (archive) {
+		const QFileInfo info{archive->fileName()};
+
+		hash.addData(archive->fileName().toUtf8());
+		hash.addData(QByteArray::number(info.lastModified().toMSecsSinceEpoch()));
+		hash.addData(QByteArray::number(info.size()));
+	}
+
+	foreach (const QString& file, files) {
+		hash.addData(file.toUtf8());
+
+		if (archive)
+			continue;
+
+		// Resources have no reliable modification time, but reading them doesn't touch the disk
+		if (file.startsWith(QLatin1Char(':'))) {
+			hash.addData(Application::readAllFileByteContents(file));
+			continue;
+		}
+
+		const QFileInfo info{file};
+
+		hash.addData(QByteArray::number(info.exists() ? info.lastModified().toMSecsSinceEpoch() : -1));
+		hash.addData(QByteArray::number(info.size()));
+	}
+
+	for (const char* name : COLOR_NAMES) {
+		for (const char* variant : COLOR_VARIANTS)
+			hash.addData(m_colors.value(colorId(name, variant)).toUtf8());
+	}
+
+	return hash.result().toHex();
+}
+}
@@ -0,0 +1,68 @@
+/***********************************************************************************
+** MIT License                                                                    **
+**                                                                                **
+** Copyright (c) 2018 Victor DENIS (victordenis01@gmail.com)                      **
+**                                                                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+***********************************************************************************/
+
+#pragma once
+#ifndef SIELOBROWSER_STYLESHEETCOMPILER_HPP
+#define SIELOBROWSER_STYLESHEETCOMPILER_HPP
+
+#include <QString>
+#include <QStringList>
+#include <QHash>
+
+namespace Sn {
+class ThemeArchive;
+
+/*
+ * Expand Sielo style sheets (SSS) to Qt style sheets in one pass: url() paths, sproperty, slineargradient,
+ * scolor() functions and $color/$ulightness variables. Compiled theme files are cached on disk
+ */
+class StyleSheetCompiler {
+public:
+	StyleSheetCompiler(const QString& relativePath, const QString& lightness);
+
+	QString compile(const QString& sss) const;
+	QString compileFiles(const QString& cacheName, const QStringList& files,
+						 const ThemeArchive* archive = nullptr) const;
+
+	// Paths used by url() in the last compiled style sheet, also restored from the cache
+	QStringList urls() const { return m_urls; }
+
+	static QString cacheDirectory();
+
+private:
+	bool parseUrl(const QString& sss, int& pos, QString& result) const;
+	bool parseColorFunction(const QString& sss, int& pos, QString& result) const;
+	bool parseVariable(const QString& sss, int& pos, QString& result) const;
+
+	QByteArray cacheKey(const QStringList& files, const ThemeArchive* archive) const;
+
+	QString m_relativePath{};
+	QString m_lightness{};
+	QHash<QString, QString> m_colors{};
+
+	mutable QStringList m_urls{};
+};
+}
+
+#endif //SIELOBROWSER_STYLESHEETCOMPILER_HPP
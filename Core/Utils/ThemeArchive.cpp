@@ -0,0 +1,300 @@
+/***********************************************************************************
+** MIT License                                                                    **
+**                                                                                **
+** Copyright (c) 2018 Victor DENIS (victordenis01@gmail.com)                      **
+**                                                                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+***********************************************************************************/
+
+#include "Utils/ThemeArchive.hpp"
+
+#include <QFileInfo>
+#include <QSaveFile>
+#include <QDir>
+
+#include <QDataStream>
+#include <QCryptographicHash>
+
+#include <QtConcurrent/QtConcurrentMap>
+
+namespace Sn {
+
+// Offset of the directory offset in the header, after magic and version
+static const qint64 DIRECTORY_OFFSET_POSITION = 8;
+
+ThemeArchive::ThemeArchive(const QString& fileName) :
+	m_file(fileName)
+{
+	if (!m_file.open(QIODevice::ReadOnly))
+		return;
+
+	// Entries are read straight from the mapped file, only the directory is parsed here
+	const uchar* mappedFile{m_file.map(0, m_file.size())};
+
+	if (mappedFile)
+		m_data = QByteArray::fromRawData(reinterpret_cast<const char*>(mappedFile), static_cast<int>(m_file.size()));
+	else
+		m_data = m_file.readAll();
+
+	QDataStream stream{m_data};
+	quint32 magic{0};
+
+	stream >> magic;
+
+	m_valid = magic == Magic ? readIndexed(m_data) : readLegacy(m_data);
+}
+
+ThemeArchive::~ThemeArchive()
+{
+	// Empty
+}
+
+QStringList ThemeArchive::entries() const
+{
+	return m_version == 1 ? m_legacyEntries.keys() : m_entries.keys();
+}
+
+bool ThemeArchive::contains(const QString& name) const
+{
+	const QString entryName{normalizedName(name)};
+
+	return m_version == 1 ? m_legacyEntries.contains(entryName) : m_entries.contains(entryName);
+}
+
+bool ThemeArchive::containsDirectory(const QString& name) const
+{
+	const QString prefix{normalizedName(name) + QLatin1Char('/')};
+
+	foreach (const QString& entryName, entries()) {
+		if (entryName.startsWith(prefix))
+			return true;
+	}
+
+	return false;
+}
+
+QByteArray ThemeArchive::read(const QString& name) const
+{
+	const QString entryName{normalizedName(name)};
+
+	if (m_version == 1)
+		return qUncompress(m_legacyEntries.value(entryName));
+
+	QHash<QString, Entry>::const_iterator it{m_entries.constFind(entryName)};
+
+	if (it == m_entries.constEnd())
+		return QByteArray();
+
+	const Entry& entry{it.value()};
+	const QByteArray storedData{
+		QByteArray::fromRawData(m_data.constData() + entry.offset, static_cast<int>(entry.storedSize))
+	};
+
+	// Uncompressed entries still have to be copied, the mapping only lives as long as the archive
+	return entry.compressed ? qUncompress(storedData) : QByteArray(storedData.constData(), storedData.size());
+}
+
+QString ThemeArchive::extract(const QString& name, const QString& directory) const
+{
+	const QString entryName{normalizedName(name)};
+
+	if (entryName.isEmpty() || entryName.startsWith(QLatin1String("..")) || !contains(entryName))
+		return QString();
+
+	const QString path{directory + QLatin1Char('/') + entryName};
+
+	QMutexLocker locker{&m_extractMutex};
+
+	if (QFileInfo::exists(path))
+		return path;
+
+	QDir().mkpath(QFileInfo(path).absolutePath());
+
+	QSaveFile file{path};
+
+	if (!file.open(QIODevice::WriteOnly))
+		return QString();
+
+	file.write(read(entryName));
+
+	return file.commit() ? path : QString();
+}
+
+QString ThemeArchive::normalizedName(const QString& name)
+{
+	QString entryName{QDir::cleanPath(QDir::fromNativeSeparators(name))};
+
+	while (entryName.startsWith(QLatin1Char('/')))
+		entryName.remove(0, 1);
+
+	return entryName;
+}
+
+bool ThemeArchive::write(const QString& fileName, const QVector<QPair<QString, QByteArray>>& files,
+						 int compressionLevel, QString* error, WriteStats* stats)
+{
+	struct Blob {
+		QByteArray data{};
+		QByteArray storedData{};
+		bool compressed{false};
+		quint64 offset{0};
+	};
+
+	// Content addressed: the same icon in dark/ and light/ is stored only once
+	QVector<Blob> blobs{};
+	QVector<int> entriesBlob{};
+	QHash<QByteArray, int> blobsIndex{};
+
+	entriesBlob.reserve(files.count());
+
+	for (const QPair<QString, QByteArray>& source : files) {
+		const QByteArray hash{QCryptographicHash::hash(source.second, QCryptographicHash::Sha1)};
+		QHash<QByteArray, int>::const_iterator it{blobsIndex.constFind(hash)};
+
+		if (it != blobsIndex.constEnd()) {
+			entriesBlob.append(it.value());
+			continue;
+		}
+
+		Blob blob{};
+		blob.data = source.second;
+
+		blobsIndex.insert(hash, blobs.count());
+		entriesBlob.append(blobs.count());
+		blobs.append(blob);
+	}
+
+	QtConcurrent::blockingMap(blobs, [compressionLevel](Blob& blob)
+	{
+		const QByteArray compressedData{qCompress(blob.data, compressionLevel)};
+
+		// Already compressed files (like images) are stored as is
+		blob.compressed = compressedData.size() < blob.data.size();
+		blob.storedData = blob.compressed ? compressedData : blob.data;
+	});
+
+	QSaveFile file{fileName};
+
+	if (!file.open(QIODevice::WriteOnly)) {
+		if (error)
+			*error = QStringLiteral("The destination file can't be open.");
+		return false;
+	}
+
+	QDataStream stream{&file};
+	stream.setVersion(QDataStream::Qt_5_6);
+
+	stream << Magic << Version << quint64(0) << quint32(files.count());
+
+	for (Blob& blob : blobs) {
+		blob.offset = static_cast<quint64>(file.pos());
+		stream.writeRawData(blob.storedData.constData(), blob.storedData.size());
+	}
+
+	const quint64 directoryOffset{static_cast<quint64>(file.pos())};
+
+	for (int i{0}; i < files.count(); ++i) {
+		const Blob& blob{blobs[entriesBlob[i]]};
+
+		stream << normalizedName(files[i].first) << blob.offset << quint32(blob.storedData.size())
+			   << quint32(blob.data.size()) << quint8(blob.compressed ? 1 : 0);
+	}
+
+	const qint64 archiveSize{file.pos()};
+
+	file.seek(DIRECTORY_OFFSET_POSITION);
+	stream << directoryOffset;
+
+	if (stream.status() != QDataStream::Ok || !file.commit()) {
+		if (error)
+			*error = QStringLiteral("Failed to write the archive.");
+		return false;
+	}
+
+	if (stats) {
+		stats->files = files.count();
+		stats->uniqueFiles = blobs.count();
+		stats->inputSize = 0;
+		stats->outputSize = archiveSize;
+
+		for (const QPair<QString, QByteArray>& source : files)
+			stats->inputSize += source.second.size();
+	}
+
+	return true;
+}
+
+bool ThemeArchive::readIndexed(const QByteArray& data)
+{
+	QDataStream stream{data};
+	stream.setVersion(QDataStream::Qt_5_6);
+
+	quint32 magic{0};
+	quint32 version{0};
+	quint64 directoryOffset{0};
+	quint32 entriesCount{0};
+
+	stream >> magic >> version >> directoryOffset >> entriesCount;
+
+	if (stream.status() != QDataStream::Ok || version != Version || directoryOffset > static_cast<quint64>(data.size()))
+		return false;
+
+	stream.device()->seek(static_cast<qint64>(directoryOffset));
+
+	for (quint32 i{0}; i < entriesCount; ++i) {
+		Entry entry{};
+		quint8 flags{0};
+
+		stream >> entry.name >> entry.offset >> entry.storedSize >> entry.size >> flags;
+
+		// Written so that a huge offset or size can't wrap around
+		if (stream.status() != QDataStream::Ok || entry.offset > directoryOffset
+			|| entry.storedSize > directoryOffset - entry.offset)
+			return false;
+
+		entry.compressed = flags & 1;
+		m_entries.insert(normalizedName(entry.name), entry);
+	}
+
+	m_version = static_cast<int>(version);
+
+	return true;
+}
+
+bool ThemeArchive::readLegacy(const QByteArray& data)
+{
+	QDataStream stream{data};
+
+	while (!stream.atEnd()) {
+		QString name{};
+		QByteArray compressedData{};
+
+		stream >> name >> compressedData;
+
+		if (stream.status() != QDataStream::Ok)
+			return false;
+
+		m_legacyEntries.insert(normalizedName(name), compressedData);
+	}
+
+	m_version = 1;
+
+	return true;
+}
+}
@@ -0,0 +1,110 @@
+/***********************************************************************************
+** MIT License                                                                    **
+**                                                                                **
+** Copyright (c) 2018 Victor DENIS (victordenis01@gmail.com)                      **
+**                                                                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+***********************************************************************************/
+
+#pragma once
+#ifndef SIELOBROWSER_THEMEARCHIVE_HPP
+#define SIELOBROWSER_THEMEARCHIVE_HPP
+
+#include <QString>
+#include <QStringList>
+#include <QByteArray>
+
+#include <QHash>
+#include <QVector>
+#include <QPair>
+
+#include <QFile>
+#include <QMutex>
+
+namespace Sn {
+
+/*
+ * Random access reader and writer for .snthm theme archives.
+ *
+ * Version 2 archives start with a header (magic, version, directory offset, entries count), followed by
+ * entries data, each one compressed on its own, and end with a central directory giving name, offset and
+ * sizes of every entry. Entries with the same content share the same data. Entries are read from the mapped
+ * file on demand.
+ * Version 1 archives (a sequential stream of name and compressed data) can still be read.
+ */
+class ThemeArchive {
+public:
+	struct Entry {
+		QString name{};
+		quint64 offset{0};
+		quint32 storedSize{0};
+		quint32 size{0};
+		bool compressed{false};
+	};
+
+	struct WriteStats {
+		int files{0};
+		int uniqueFiles{0};
+		qint64 inputSize{0}; // In bytes
+		qint64 outputSize{0}; // In bytes
+	};
+
+	static const quint32 Magic = 0x534E544D; // "SNTM"
+	static const quint32 Version = 2;
+
+	ThemeArchive(const QString& fileName);
+	~ThemeArchive();
+
+	bool isValid() const { return m_valid; }
+	int version() const { return m_version; }
+	QString fileName() const { return m_file.fileName(); }
+
+	QStringList entries() const;
+	bool contains(const QString& name) const;
+	bool containsDirectory(const QString& name) const;
+	QByteArray read(const QString& name) const;
+
+	// Write the entry in directory (if not already there) and return its path, for APIs that need real files
+	QString extract(const QString& name, const QString& directory) const;
+
+	static QString normalizedName(const QString& name);
+	// Identical files are stored once, and compressed in parallel. Level is zlib one (-1 for default)
+	static bool write(const QString& fileName, const QVector<QPair<QString, QByteArray>>& files,
+					  int compressionLevel = -1, QString* error = nullptr, WriteStats* stats = nullptr);
+
+private:
+	bool readIndexed(const QByteArray& data);
+	bool readLegacy(const QByteArray& data);
+
+	QFile m_file{};
+	QByteArray m_data{};
+
+	QHash<QString, Entry> m_entries{};
+	QHash<QString, QByteArray> m_legacyEntries{};
+
+	bool m_valid{false};
+	int m_version{0};
+
+	mutable QMutex m_extractMutex{};
+};
+}
+
+Q_DECLARE_TYPEINFO(Sn::ThemeArchive::Entry, Q_MOVABLE_TYPE);
+
+#endif //SIELOBROWSER_THEMEARCHIVE_HPP
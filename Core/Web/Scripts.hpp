@@ -213,6 +213,35 @@ public:
 		return source;
 	}
 
+	static QString hasModifiedForms()
+	{
+		QString source = QLatin1String("(function() {"
+			"var inputs = document.querySelectorAll('input, textarea');"
+			"for (var i = 0; i < inputs.length; ++i) {"
+			"    var e = inputs[i];"
+			"    var type = (e.type || '').toLowerCase();"
+			"    if (type == 'hidden' || type == 'submit' || type == 'button' || type == 'reset' || type == 'image')"
+			"        continue;"
+			"    if (type == 'checkbox' || type == 'radio') {"
+			"        if (e.checked != e.defaultChecked)"
+			"            return true;"
+			"    }"
+			"    else if (e.value != e.defaultValue)"
+			"        return true;"
+			"}"
+			"var selects = document.getElementsByTagName('select');"
+			"for (var i = 0; i < selects.length; ++i) {"
+			"    var options = selects[i].options;"
+			"    for (var j = 0; j < options.length; ++j)"
+			"        if (options[j].selected != options[j].defaultSelected)"
+			"            return true;"
+			"}"
+			"return false;"
+			"})()");
+
+		return source;
+	}
+
 };
 }
 
@@ -0,0 +1,197 @@
+/***********************************************************************************
+** MIT License                                                                    **
+**                                                                                **
+** Copyright (c) 2018 Victor DENIS (victordenis01@gmail.com)                      **
+**                                                                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+***********************************************************************************/
+
+#include "Web/Tab/TabsLifecycleManager.hpp"
+
+#include <QSettings>
+#include <QDateTime>
+
+#include <algorithm>
+
+#include "Application.hpp"
+#include "BrowserWindow.hpp"
+
+#include "Web/Tab/WebTab.hpp"
+
+#include "Widgets/Tab/TabWidget.hpp"
+
+namespace Sn {
+
+static const int CHECK_INTERVAL = 1000 * 60;
+static const int SCHEDULE_DELAY = 1000 * 2;
+
+TabsLifecycleManager::TabsLifecycleManager(QObject* parent) :
+	QObject(parent)
+{
+	m_checkTimer = new QTimer(this);
+	m_checkTimer->setInterval(CHECK_INTERVAL);
+
+	m_scheduleTimer = new QTimer(this);
+	m_scheduleTimer->setSingleShot(true);
+	m_scheduleTimer->setInterval(SCHEDULE_DELAY);
+
+	connect(m_checkTimer, &QTimer::timeout, this, &TabsLifecycleManager::discardTabs);
+	connect(m_checkTimer, &QTimer::timeout, this, &TabsLifecycleManager::freezeTabs);
+	connect(m_scheduleTimer, &QTimer::timeout, this, &TabsLifecycleManager::discardTabs);
+
+	loadSettings();
+}
+
+TabsLifecycleManager::~TabsLifecycleManager()
+{
+	// Empty
+}
+
+void TabsLifecycleManager::loadSettings()
+{
+	QSettings settings{};
+
+	settings.beginGroup("Web-Settings");
+
+	// Off until the budget can be set from the preferences, the tab count estimate is too rough to be a default
+	m_enabled = settings.value("discardBackgroundTabs", false).toBool();
+	m_memoryBudget = qMax(1, settings.value("tabsMemoryBudget", 2048).toInt());
+	m_tabMemoryEstimate = qMax(1, settings.value("tabMemoryEstimate", 150).toInt());
+	m_discardAfter = qMax(0, settings.value("discardTabsAfter", 0).toInt());
+	// Off until freezing is measured to save more than the cost of resuming tabs
+	m_freezeHiddenTabs = settings.value("freezeHiddenTabs", false).toBool();
+	m_freezeAfter = qMax(0, settings.value("freezeTabsAfter", 300).toInt());
+
+	settings.endGroup();
+
+	if (!m_suspended && (m_enabled || m_freezeHiddenTabs))
+		m_checkTimer->start();
+	else
+		m_checkTimer->stop();
+}
+
+void TabsLifecycleManager::setSuspended(bool suspended)
+{
+	m_suspended = suspended;
+
+	if (m_suspended) {
+		m_checkTimer->stop();
+		m_scheduleTimer->stop();
+	}
+	else
+		loadSettings();
+}
+
+int TabsLifecycleManager::maximumLoadedTabs() const
+{
+	// QtWebEngine does not tell how much memory each renderer use, so the budget is shared with an estimated cost
+	return qMax(1, m_memoryBudget / m_tabMemoryEstimate);
+}
+
+bool TabsLifecycleManager::canDiscard(WebTab* tab) const
+{
+	if (!tab->isRestored() || !tab->tabBar())
+		return false;
+
+	// Visible, pinned and playing tabs are never discarded, nor tabs with text typed in a form
+	if (tab->isCurrentTab() || tab->isVisible() || tab->isPinned() || tab->isAudible() || tab->hasModifiedForms())
+		return false;
+
+	return !tab->isLoading() && !tab->inspector();
+}
+
+bool TabsLifecycleManager::canFreeze(WebTab* tab) const
+{
+	if (!tab->isRestored() || tab->isFrozen())
+		return false;
+
+	// Tabs shown in a tabs space with a real size keep running
+	if (tab->isVisible() && !tab->size().isEmpty() && !tab->window()->isMinimized())
+		return false;
+
+	return !tab->isAudible() && !tab->isLoading() && !tab->inspector();
+}
+
+void TabsLifecycleManager::scheduleCheck()
+{
+	if (m_enabled && !m_suspended)
+		m_scheduleTimer->start();
+}
+
+void TabsLifecycleManager::discardTabs()
+{
+	if (!m_enabled || m_suspended || Application::instance()->isClosing())
+		return;
+
+	QList<WebTab*> tabs{loadedTabs()};
+	int loadedCount{tabs.count()};
+	const int maximum{maximumLoadedTabs()};
+	const qint64 expiration{m_discardAfter > 0
+		? QDateTime::currentMSecsSinceEpoch() - qint64(m_discardAfter) * 60 * 1000
+		: 0};
+
+	std::sort(tabs.begin(), tabs.end(), [](WebTab* left, WebTab* right)
+	{
+		return left->lastActivation() < right->lastActivation();
+	});
+
+	foreach (WebTab* tab, tabs) {
+		const bool overBudget{loadedCount > maximum};
+		const bool expired{expiration > 0 && tab->lastActivation() < expiration};
+
+		if (!overBudget && !expired)
+			break;
+
+		if (!canDiscard(tab))
+			continue;
+
+		tab->discard();
+		--loadedCount;
+	}
+}
+
+void TabsLifecycleManager::freezeTabs()
+{
+	if (!m_freezeHiddenTabs || m_suspended || Application::instance()->isClosing())
+		return;
+
+	const qint64 expiration{QDateTime::currentMSecsSinceEpoch() - qint64(m_freezeAfter) * 1000};
+
+	foreach (WebTab* tab, loadedTabs()) {
+		if (tab->lastActivation() < expiration && canFreeze(tab))
+			tab->freeze();
+	}
+}
+
+QList<WebTab*> TabsLifecycleManager::loadedTabs() const
+{
+	QList<WebTab*> tabs{};
+
+	foreach (BrowserWindow* window, Application::instance()->windows()) {
+		foreach (TabWidget* tabWidget, window->tabWidgets()) {
+			foreach (WebTab* tab, tabWidget->allTabs()) {
+				if (tab->isRestored())
+					tabs.append(tab);
+			}
+		}
+	}
+
+	return tabs;
+}
+}
@@ -0,0 +1,79 @@
+/***********************************************************************************
+** MIT License                                                                    **
+**                                                                                **
+** Copyright (c) 2018 Victor DENIS (victordenis01@gmail.com)                      **
+**                                                                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+***********************************************************************************/
+
+#pragma once
+#ifndef SIELOBROWSER_TABSLIFECYCLEMANAGER_HPP
+#define SIELOBROWSER_TABSLIFECYCLEMANAGER_HPP
+
+#include <QObject>
+#include <QTimer>
+
+#include <QList>
+
+namespace Sn {
+class WebTab;
+
+/* Freeze hidden tabs, and discard least recently used background tabs when the loaded tabs go over the memory budget */
+class TabsLifecycleManager: public QObject {
+Q_OBJECT
+
+public:
+	TabsLifecycleManager(QObject* parent = nullptr);
+	~TabsLifecycleManager();
+
+	void loadSettings();
+
+	bool isEnabled() const { return m_enabled; }
+
+	// No tab is discarded or frozen while suspended, whatever the settings (used by benchmarks)
+	bool isSuspended() const { return m_suspended; }
+	void setSuspended(bool suspended);
+	int maximumLoadedTabs() const;
+
+	bool canDiscard(WebTab* tab) const;
+	bool canFreeze(WebTab* tab) const;
+
+public slots:
+	void scheduleCheck();
+	void discardTabs();
+	void freezeTabs();
+
+private:
+	QList<WebTab*> loadedTabs() const;
+
+	QTimer* m_checkTimer{nullptr};
+	QTimer* m_scheduleTimer{nullptr};
+
+	bool m_suspended{false};
+	bool m_enabled{false};
+	int m_memoryBudget{2048}; // In MB
+	int m_tabMemoryEstimate{150}; // In MB
+	int m_discardAfter{0}; // In minutes, 0 to only respect the budget
+
+	bool m_freezeHiddenTabs{false};
+	int m_freezeAfter{300}; // In seconds
+};
+}
+
+#endif //SIELOBROWSER_TABSLIFECYCLEMANAGER_HPP
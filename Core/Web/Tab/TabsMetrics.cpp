@@ -0,0 +1,178 @@
+/***********************************************************************************
+** MIT License                                                                    **
+**                                                                                **
+** Copyright (c) 2018 Victor DENIS (victordenis01@gmail.com)                      **
+**                                                                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+***********************************************************************************/
+
+#include "Web/Tab/TabsMetrics.hpp"
+
+#include <QFile>
+#include <QDateTime>
+
+#include <QJsonObject>
+#include <QJsonArray>
+
+#ifdef Q_OS_LINUX
+#include <unistd.h>
+#endif
+
+#include "Application.hpp"
+#include "BrowserWindow.hpp"
+
+#include "Web/WebPage.hpp"
+#include "Web/Tab/WebTab.hpp"
+#include "Web/Tab/TabbedWebView.hpp"
+
+#include "Widgets/Tab/TabWidget.hpp"
+
+namespace Sn {
+
+// Hosts seen after this many are not counted, so the counters can't grow for ever
+static const int MAX_BLOCKED_HOSTS = 1000;
+
+TabsMetrics::TabsMetrics(QObject* parent) :
+	QObject(parent)
+{
+	// Empty
+}
+
+TabsMetrics::~TabsMetrics()
+{
+	// Empty
+}
+
+TabsMetrics::Sample TabsMetrics::sampleTab(WebTab* tab) const
+{
+	Sample sample{};
+
+	sample.title = tab->title();
+	sample.url = tab->url();
+	sample.loaded = tab->isRestored();
+	sample.frozen = tab->isFrozen();
+
+	// Don't create the view of a placeholder tab just to sample it
+	if (!tab->hasWebView())
+		return sample;
+
+	WebPage* page{tab->webView()->page()};
+
+	sample.blockedRequests = static_cast<qint64>(blockedRequests(sample.url.host().toLower()));
+	sample.processId = page->renderProcessId();
+	sample.memory = processMemory(sample.processId);
+	sample.lastLoadTime = page->lastLoadTime();
+	sample.loadCount = page->loadCount();
+	sample.javaScriptDialogs = page->javaScriptDialogsCount();
+	sample.consoleMessages = page->consoleMessagesCount();
+	sample.scriptErrors = page->scriptErrorsCount();
+
+	return sample;
+}
+
+QVector<TabsMetrics::Sample> TabsMetrics::sample() const
+{
+	QVector<Sample> samples{};
+
+	foreach (BrowserWindow* window, Application::instance()->windows()) {
+		foreach (TabWidget* tabWidget, window->tabWidgets()) {
+			foreach (WebTab* tab, tabWidget->allTabs()) samples.append(sampleTab(tab));
+		}
+	}
+
+	return samples;
+}
+
+quint64 TabsMetrics::blockedRequests(const QString& host) const
+{
+	QMutexLocker locker{&m_blockedMutex};
+	return m_blockedRequests.value(host);
+}
+
+void TabsMetrics::addBlockedRequest(const QString& firstPartyHost)
+{
+	if (firstPartyHost.isEmpty())
+		return;
+
+	QMutexLocker locker{&m_blockedMutex};
+
+	auto it = m_blockedRequests.find(firstPartyHost);
+
+	if (it != m_blockedRequests.end())
+		++it.value();
+	else if (m_blockedRequests.size() < MAX_BLOCKED_HOSTS)
+		m_blockedRequests.insert(firstPartyHost, 1);
+}
+
+qint64 TabsMetrics::processMemory(qint64 processId)
+{
+	if (processId <= 0)
+		return -1;
+
+#ifdef Q_OS_LINUX
+	// Second field of statm is the resident set size, in pages
+	QFile statm{QString("/proc/%1/statm").arg(processId)};
+
+	if (!statm.open(QIODevice::ReadOnly))
+		return -1;
+
+	const QList<QByteArray> fields{statm.readAll().split(' ')};
+
+	if (fields.size() < 2)
+		return -1;
+
+	bool ok{false};
+	const qint64 pages{fields[1].toLongLong(&ok)};
+
+	return ok ? pages * sysconf(_SC_PAGESIZE) : -1;
+#else
+	return -1;
+#endif
+}
+
+QJsonDocument TabsMetrics::toJson(const QVector<Sample>& samples)
+{
+	QJsonArray tabs{};
+
+	foreach (const Sample& sample, samples) {
+		QJsonObject tab{};
+
+		tab.insert("title", sample.title);
+		tab.insert("url", sample.url.toString());
+		tab.insert("processId", sample.processId);
+		tab.insert("memory", sample.memory);
+		tab.insert("lastLoadTime", sample.lastLoadTime);
+		tab.insert("loadCount", sample.loadCount);
+		tab.insert("blockedRequests", sample.blockedRequests);
+		tab.insert("javaScriptDialogs", sample.javaScriptDialogs);
+		tab.insert("consoleMessages", sample.consoleMessages);
+		tab.insert("scriptErrors", sample.scriptErrors);
+		tab.insert("loaded", sample.loaded);
+		tab.insert("frozen", sample.frozen);
+
+		tabs.append(tab);
+	}
+
+	QJsonObject root{};
+	root.insert("timestamp", QDateTime::currentDateTime().toString(Qt::ISODate));
+	root.insert("tabs", tabs);
+
+	return QJsonDocument(root);
+}
+}
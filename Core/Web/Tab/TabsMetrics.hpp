@@ -0,0 +1,82 @@
+/***********************************************************************************
+** MIT License                                                                    **
+**                                                                                **
+** Copyright (c) 2018 Victor DENIS (victordenis01@gmail.com)                      **
+**                                                                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+***********************************************************************************/
+
+#pragma once
+#ifndef SIELOBROWSER_TABSMETRICS_HPP
+#define SIELOBROWSER_TABSMETRICS_HPP
+
+#include <QObject>
+
+#include <QHash>
+#include <QVector>
+#include <QMutex>
+
+#include <QUrl>
+#include <QJsonDocument>
+
+namespace Sn {
+class WebTab;
+
+/* Collect resource usage of every tab, so it can be displayed in the task manager or exported */
+class TabsMetrics: public QObject {
+Q_OBJECT
+
+public:
+	struct Sample {
+		QString title{};
+		QUrl url{};
+		qint64 processId{-1};
+		qint64 memory{-1}; // In bytes, -1 if unknown
+		qint64 lastLoadTime{-1}; // In ms, -1 if never loaded
+		int loadCount{0};
+		qint64 blockedRequests{0}; // On the host of the tab since startup
+		int javaScriptDialogs{0};
+		int consoleMessages{0};
+		int scriptErrors{0};
+		bool loaded{false};
+		bool frozen{false};
+	};
+
+	TabsMetrics(QObject* parent = nullptr);
+	~TabsMetrics();
+
+	Sample sampleTab(WebTab* tab) const;
+	QVector<Sample> sample() const;
+
+	// Blocked requests are counted per first party host, requests don't tell which page sent them
+	quint64 blockedRequests(const QString& host) const;
+
+	// Thread safe, called from the network interceptors
+	void addBlockedRequest(const QString& firstPartyHost);
+
+	static qint64 processMemory(qint64 processId);
+	static QJsonDocument toJson(const QVector<Sample>& samples);
+
+private:
+	mutable QMutex m_blockedMutex{};
+	QHash<QString, quint64> m_blockedRequests{};
+};
+}
+
+#endif //SIELOBROWSER_TABSMETRICS_HPP
@@ -25,6 +25,7 @@
 #include "Web/Tab/WebTab.hpp"
 
 #include <QSettings>
+#include <QDateTime>
 
 #include <QColor>
 #include <QLineEdit>
@@ -35,6 +36,8 @@
 #include "Web/WebInspector.hpp"
 #include "Web/Tab/TabbedWebView.hpp"
 
+#include "Utils/SettingsCache.hpp"
+
 #include "Widgets/FloatingButton.hpp"
 #include "Widgets/SearchToolBar.hpp"
 #include "Widgets/Tab/TabWidget.hpp"
@@ -51,10 +54,7 @@ bool WebTab::s_pinningTab = false;
 WebTab::SavedTab::SavedTab() :
 	isPinned(false)
 {
-	QSettings settings{};
-	int defaultZoomLevel{settings.value("Web-Settings/defaultZoomLevel", WebView::zoomLevels().indexOf(100)).toInt()};
-
-	zoomLevel = defaultZoomLevel;
+	zoomLevel = SettingsCache::instance()->defaultZoomLevel();
 }
 
 WebTab::SavedTab::SavedTab(WebTab* webTab)
@@ -74,14 +74,11 @@ bool WebTab::SavedTab::isValide() const
 
 void WebTab::SavedTab::clear()
 {
-	QSettings settings{};
-	int defaultZoomLevel{settings.value("Web-Settings/defaultZoomLevel", WebView::zoomLevels().indexOf(100)).toInt()};
-
 	title.clear();
 	url.clear();
 	icon = QIcon();
 	isPinned = false;
-	zoomLevel = defaultZoomLevel;
+	zoomLevel = SettingsCache::instance()->defaultZoomLevel();
 }
 
 QDataStream& operator<<(QDataStream& stream, const WebTab::SavedTab& tab)
@@ -116,8 +113,6 @@ QDataStream& operator>>(QDataStream& stream, WebTab::SavedTab& tab)
 	 *     stream >> xxx
 	 */
 
-	QPixmap pixmap{};
-
 	stream >> tab.title;
 	stream >> tab.url;
 //	stream >> pixmap;
@@ -125,7 +120,8 @@ QDataStream& operator>>(QDataStream& stream, WebTab::SavedTab& tab)
 	stream >> tab.isPinned;
 	stream >> tab.zoomLevel;
 
-	tab.icon = Application::getAppIcon("webpage");
+	// No icon is stored, WebTab::icon() falls back to the default one. It also keeps
+	// this operator usable outside of the GUI thread.
 
 	return stream;
 }
@@ -133,7 +129,34 @@ QDataStream& operator>>(QDataStream& stream, WebTab::SavedTab& tab)
 WebTab::WebTab(BrowserWindow* window) :
 	QWidget(),
 	m_window(window),
-	m_isPinned(false)
+	m_isPinned(false),
+	m_lastActivation(QDateTime::currentMSecsSinceEpoch())
+{
+	setupTab();
+	createWebView();
+}
+
+WebTab::WebTab(BrowserWindow* window, const SavedTab& tab) :
+	QWidget(),
+	m_window(window),
+	m_savedTab(tab),
+	m_isPinned(tab.isPinned),
+	m_lastActivation(QDateTime::currentMSecsSinceEpoch())
+{
+	// Placeholder tab: the web view is only created when the tab is activated
+	setupTab();
+	m_tabIcon->setWebTab(this);
+}
+
+TabbedWebView* WebTab::ensureWebView()
+{
+	if (!m_webView)
+		createWebView();
+
+	return m_webView;
+}
+
+void WebTab::setupTab()
 {
 	setObjectName(QLatin1String("webtab"));
 	//setStyleSheet("#webtab {background-color: white;}");
@@ -142,9 +165,26 @@ WebTab::WebTab(BrowserWindow* window) :
 	m_layout->setSpacing(0);
 	m_layout->setContentsMargins(0, 0, 0, 0);
 
+	m_tabIcon = new TabIcon(this);
+
+	connect(m_tabIcon, &TabIcon::resized, this, [this]()
+	{
+		if (m_tabBar)
+			m_tabBar->setTabButton(tabIndex(), m_tabBar->iconButtonPosition(), m_tabIcon);
+	});
+
+	setLayout(m_layout);
+}
+
+void WebTab::createWebView()
+{
+	if (m_webView)
+		return;
+
 	m_webView = new TabbedWebView(this);
 	m_webView->setBrowserWindow(m_window);
 	m_webView->setWebPage(new WebPage);
+	m_webView->page()->setAudioMuted(m_isMuted);
 	m_webView->setSizePolicy(QSizePolicy::Preferred, QSizePolicy::Expanding);
 
 	m_splitter = new QSplitter(Qt::Vertical, this);
@@ -153,9 +193,6 @@ WebTab::WebTab(BrowserWindow* window) :
 	m_splitter->addWidget(m_webView);
 	//m_splitter->setStyleSheet("background: white");
 
-	m_tabIcon = new TabIcon(this);
-	m_tabIcon->setWebTab(this);
-
 	m_menuForward = new QMenu(this);
 
 //	m_fButton->setPattern(FloatingButton::Toolbar);
@@ -164,6 +201,9 @@ WebTab::WebTab(BrowserWindow* window) :
 	m_addressBar->setWebView(m_webView);
 	m_addressBar->setText("https://google.com");
 
+	if (!isRestored())
+		m_addressBar->showUrl(m_savedTab.url);
+
 	m_layout->addWidget(m_addressBar);
 	m_layout->addWidget(m_splitter);
 
@@ -171,14 +211,18 @@ WebTab::WebTab(BrowserWindow* window) :
 	connect(m_webView, &TabbedWebView::loadStarted, this, &WebTab::loadStarted);
 	connect(m_webView, &TabbedWebView::loadFinished, this, &WebTab::loadFinished);
 	connect(m_webView, &TabbedWebView::titleChanged, this, &WebTab::titleChanged);
-	connect(m_tabIcon, &TabIcon::resized, this, [this]()
-	{
-		if (m_tabBar)
-			m_tabBar->setTabButton(tabIndex(), m_tabBar->iconButtonPosition(), m_tabIcon);
-	});
 
-	setLayout(m_layout);
+	// Everything stored in the session comes from these
+	connect(m_webView, &TabbedWebView::urlChanged, this, &WebTab::sessionStateChanged);
+	connect(m_webView, &TabbedWebView::titleChanged, this, &WebTab::sessionStateChanged);
+	connect(m_webView, &TabbedWebView::loadFinished, this, &WebTab::sessionStateChanged);
+	connect(m_webView, &TabbedWebView::zoomLevelChanged, this, &WebTab::sessionStateChanged);
+
+	m_tabIcon->setWebTab(this);
 
+	// Placeholder tabs are already in a tabs space, let it connect to the new view
+	if (m_tabBar)
+		m_tabBar->tabWidget()->setupWebView(this);
 }
 
 QUrl WebTab::url() const
@@ -210,17 +254,25 @@ QIcon WebTab::icon(bool allowNull) const
 
 QWebEngineHistory* WebTab::history() const
 {
-	return m_webView->history();
+	return m_webView ? m_webView->history() : nullptr;
 }
 
 int WebTab::zoomLevel() const
 {
+	if (!m_webView)
+		return m_savedTab.zoomLevel;
+
 	return m_webView->zoomLevel();
 }
 
 void WebTab::setZoomLevel(int level)
 {
-	m_webView->setZoomLevel(level);
+	if (!m_webView)
+		m_savedTab.zoomLevel = level;
+	else
+		m_webView->setZoomLevel(level);
+
+	sessionStateChanged();
 }
 
 void WebTab::detach()
@@ -229,7 +281,9 @@ void WebTab::detach()
 
 	m_tabBar->setTabButton(tabIndex(), m_tabBar->iconButtonPosition(), nullptr);
 	setParent(nullptr);
-	m_webView->setBrowserWindow(nullptr);
+
+	if (m_webView)
+		m_webView->setBrowserWindow(nullptr);
 
 	m_window = nullptr;
 	m_tabBar = nullptr;
@@ -240,7 +294,9 @@ void WebTab::attach(TabWidget* tabWidget)
 	m_window = tabWidget->window();
 	m_tabBar = tabWidget->tabBar();
 
-	m_webView->setBrowserWindow(tabWidget->window());
+	if (m_webView)
+		m_webView->setBrowserWindow(tabWidget->window());
+
 	m_tabBar->setTabButton(tabIndex(), m_tabBar->iconButtonPosition(), m_tabIcon);
 	m_tabBar->setTabText(tabIndex(), title());
 }
@@ -271,22 +327,38 @@ QByteArray WebTab::historyData() const
 
 void WebTab::setHistoryData(const QByteArray& data)
 {
-	m_webView->restoreHistory(data);
+	ensureWebView()->restoreHistory(data);
+}
+
+QByteArray WebTab::sessionData()
+{
+	if (m_sessionDataChanged || m_sessionData.isEmpty()) {
+		m_sessionData.clear();
+
+		QDataStream stream{&m_sessionData, QIODevice::WriteOnly};
+		stream << SavedTab(this);
+
+		m_sessionDataChanged = false;
+	}
+
+	return m_sessionData;
 }
 
 void WebTab::stop()
 {
-	m_webView->stop();
+	if (m_webView)
+		m_webView->stop();
 }
 
 void WebTab::reload()
 {
-	m_webView->reload();
+	if (m_webView)
+		m_webView->reload();
 }
 
 bool WebTab::isLoading() const
 {
-	return m_webView->isLoading();
+	return m_webView && m_webView->isLoading();
 }
 
 bool WebTab::isPinned() const
@@ -297,6 +369,7 @@ bool WebTab::isPinned() const
 void WebTab::setPinned(bool state)
 {
 	m_isPinned = state;
+	sessionStateChanged();
 }
 
 void WebTab::togglePinned()
@@ -305,6 +378,7 @@ void WebTab::togglePinned()
 	Q_ASSERT(m_tabBar);
 
 	m_isPinned = !m_isPinned;
+	sessionStateChanged();
 
 	s_pinningTab = true;
 	m_window->tabWidget()->pinUnPinTab(tabIndex(), title());
@@ -313,12 +387,18 @@ void WebTab::togglePinned()
 
 bool WebTab::isMuted() const
 {
+	if (!m_webView)
+		return m_isMuted;
+
 	return m_webView->page()->isAudioMuted();
 }
 
 void WebTab::setMuted(bool muted)
 {
-	m_webView->page()->setAudioMuted(muted);
+	m_isMuted = muted;
+
+	if (m_webView)
+		m_webView->page()->setAudioMuted(muted);
 }
 
 void WebTab::toggleMuted()
@@ -326,6 +406,16 @@ void WebTab::toggleMuted()
 	setMuted(!isMuted());
 }
 
+bool WebTab::isAudible() const
+{
+	return m_webView && m_webView->page()->recentlyAudible();
+}
+
+bool WebTab::hasModifiedForms() const
+{
+	return m_webView && m_webView->page()->hasModifiedForms();
+}
+
 int WebTab::tabIndex() const
 {
 	Q_ASSERT(m_tabBar);
@@ -369,25 +459,11 @@ void WebTab::restoreTab(const SavedTab& tab)
 	QSettings settings{};
 
 	m_isPinned = tab.isPinned;
+	sessionStateChanged();
 
 	if (!isPinned() && settings.value("Web-Settings/LoadTabsOnActivation", true).toBool()) {
 		m_savedTab = tab;
-		int index = tabIndex();
-
-		m_tabBar->setTabText(index, tab.title);
-		m_addressBar->showUrl(tab.url);
-		m_tabIcon->updateIcon();
-
-		if (!tab.url.isEmpty()) {
-			QColor color{m_tabBar->palette().text().color()};
-			QColor newColor{color.lighter(250)};
-
-			if (color == Qt::black || color == Qt::white)
-				newColor = Qt::gray;
-
-			m_tabBar->overrideTabTextColor(index, newColor);
-
-		}
+		showUnrestoredTab(tab);
 	}
 	else {
 		QTimer::singleShot(1000, this, [=]()
@@ -397,6 +473,98 @@ void WebTab::restoreTab(const SavedTab& tab)
 	}
 }
 
+void WebTab::discard()
+{
+	Q_ASSERT(m_tabBar);
+
+	if (!isRestored() || isCurrentTab())
+		return;
+
+	SavedTab tab{this};
+
+	if (!tab.isValide())
+		return;
+
+	const bool muted{isMuted()};
+	WebPage* oldPage{m_webView->page()};
+
+	// A fresh page has no renderer process until something is loaded in it
+	m_webView->setWebPage(new WebPage);
+	m_webView->page()->setAudioMuted(muted);
+	m_tabIcon->setWebTab(this);
+
+	oldPage->deleteLater();
+
+	m_savedTab = tab;
+	showUnrestoredTab(tab);
+	sessionStateChanged();
+}
+
+bool WebTab::isFrozen() const
+{
+#if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
+	return m_webView && m_webView->page()->lifecycleState() == QWebEnginePage::LifecycleState::Frozen;
+#else
+	return false;
+#endif
+}
+
+void WebTab::freeze()
+{
+#if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
+	if (!m_webView || isFrozen() || isAudible() || isLoading())
+		return;
+
+	WebPage* page{m_webView->page()};
+
+	// Pages of collapsed tabs spaces or minimized windows are still visible for the engine,
+	// which refuses to freeze them
+	if (page->isVisible() && (!isVisible() || size().isEmpty() || window()->isMinimized()))
+		page->setVisible(false);
+
+	if (!page->isVisible())
+		page->setLifecycleState(QWebEnginePage::LifecycleState::Frozen);
+#endif
+}
+
+void WebTab::resume()
+{
+#if QT_VERSION >= QT_VERSION_CHECK(5, 14, 0)
+	if (!m_webView)
+		return;
+
+	WebPage* page{m_webView->page()};
+
+	if (isVisible() && !size().isEmpty() && !page->isVisible())
+		page->setVisible(true);
+
+	if (page->lifecycleState() != QWebEnginePage::LifecycleState::Active)
+		page->setLifecycleState(QWebEnginePage::LifecycleState::Active);
+#endif
+}
+
+void WebTab::showUnrestoredTab(const SavedTab& tab)
+{
+	int index = tabIndex();
+
+	m_tabBar->setTabText(index, tab.title);
+	m_tabIcon->updateIcon();
+
+	if (m_addressBar)
+		m_addressBar->showUrl(tab.url);
+
+	if (!tab.url.isEmpty()) {
+		QColor color{m_tabBar->palette().text().color()};
+		QColor newColor{color.lighter(250)};
+
+		if (color == Qt::black || color == Qt::white)
+			newColor = Qt::gray;
+
+		m_tabBar->overrideTabTextColor(index, newColor);
+
+	}
+}
+
 void WebTab::p_restoreTab(const SavedTab& tab)
 {
 	p_restoreTab(tab.url, tab.history, tab.zoomLevel);
@@ -404,10 +572,12 @@ void WebTab::p_restoreTab(const SavedTab& tab)
 
 void WebTab::p_restoreTab(const QUrl& url, const QByteArray& history, int zoomLevel)
 {
-	m_webView->load(url);
-	m_webView->restoreHistory(history);
-	m_webView->setZoomLevel(zoomLevel);
-	m_webView->setFocus();
+	TabbedWebView* view{ensureWebView()};
+
+	view->load(url);
+	view->restoreHistory(history);
+	view->setZoomLevel(zoomLevel);
+	view->setFocus();
 }
 
 void WebTab::sNewWindow()
@@ -542,6 +712,10 @@ void WebTab::showEvent(QShowEvent* event)
 {
 	QWidget::showEvent(event);
 
+	m_lastActivation = QDateTime::currentMSecsSinceEpoch();
+
+	resume();
+
 	if (!isRestored() && !s_pinningTab) {
 		if (Application::instance()->isSessionRestored())
 			sRestore();
@@ -550,4 +724,30 @@ void WebTab::showEvent(QShowEvent* event)
 	}
 }
 
-}
\ No newline at end of file
+void WebTab::hideEvent(QHideEvent* event)
+{
+	QWidget::hideEvent(event);
+
+	m_lastActivation = QDateTime::currentMSecsSinceEpoch();
+
+	// Forms can only be edited while the tab is shown, check them once it is left
+	if (m_webView)
+		m_webView->page()->checkModifiedForms();
+}
+
+void WebTab::resizeEvent(QResizeEvent* event)
+{
+	QWidget::resizeEvent(event);
+
+	// A collapsed tabs space keeps its tab shown, only with an empty size
+	if (event->oldSize().isEmpty() && !event->size().isEmpty())
+		resume();
+	else if (!event->oldSize().isEmpty() && event->size().isEmpty()) {
+		m_lastActivation = QDateTime::currentMSecsSinceEpoch();
+
+		if (m_webView)
+			m_webView->page()->checkModifiedForms();
+	}
+}
+
+}
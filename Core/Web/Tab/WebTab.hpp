@@ -42,6 +42,8 @@
 #include <QUrl>
 
 #include <QShowEvent>
+#include <QHideEvent>
+#include <QResizeEvent>
 
 namespace Sn {
 class BrowserWindow;
@@ -80,9 +82,13 @@ public:
 	};
 
 	WebTab(BrowserWindow* window);
+	WebTab(BrowserWindow* window, const SavedTab& tab);
 
 	WebInspector* inspector() const { return m_inspector; }
+	// Null for placeholder tabs until they are activated
 	TabbedWebView* webView() const { return m_webView; }
+	TabbedWebView* ensureWebView();
+	bool hasWebView() const { return m_webView != nullptr; }
 	TabIcon* tabIcon() const { return m_tabIcon; }
 	AddressBar* addressBar() const { return m_addressBar; }
 	MainTabBar* tabBar() const { return m_tabBar; }
@@ -104,6 +110,9 @@ public:
 	QByteArray historyData() const;
 	void setHistoryData(const QByteArray& data);
 
+	QByteArray sessionData();
+	void sessionStateChanged() { m_sessionDataChanged = true; }
+
 	void stop();
 	void reload();
 	bool isLoading() const;
@@ -115,6 +124,8 @@ public:
 	bool isMuted() const;
 	void setMuted(bool muted);
 	void toggleMuted();
+	bool isAudible() const;
+	bool hasModifiedForms() const;
 
 	int tabIndex() const;
 
@@ -123,6 +134,10 @@ public:
 	void showSearchToolBar();
 
 	bool isRestored() const;
+	void discard();
+	bool isFrozen() const;
+	void freeze();
+	qint64 lastActivation() const { return m_lastActivation; }
 	void restoreTab(const SavedTab& tab);
 	void p_restoreTab(const SavedTab& tab);
 	void p_restoreTab(const QUrl& url, const QByteArray& history, int zoomLevel);
@@ -145,6 +160,14 @@ private slots:
 
 private:
 	void showEvent(QShowEvent* event);
+	void hideEvent(QHideEvent* event);
+	void resizeEvent(QResizeEvent* event);
+
+	void resume();
+
+	void setupTab();
+	void createWebView();
+	void showUnrestoredTab(const SavedTab& tab);
 
 	QVBoxLayout* m_layout{nullptr};
 	QSplitter* m_splitter{nullptr};
@@ -161,6 +184,11 @@ private:
 
 	SavedTab m_savedTab{};
 	bool m_isPinned{false};
+	bool m_isMuted{false};
+	qint64 m_lastActivation{0};
+
+	QByteArray m_sessionData{};
+	bool m_sessionDataChanged{true};
 
 	static bool s_pinningTab;
 };
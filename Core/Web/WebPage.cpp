@@ -49,6 +49,7 @@
 #include "Password/AutoFill/AutoFill.hpp"
 
 #include "Network/NetworkManager.hpp"
+#include "Network/HttpsUpgradeInterceptor.hpp"
 
 #include "Widgets/CheckBoxDialog.hpp"
 #include "Widgets/Tab/TabWidget.hpp"
@@ -91,8 +92,30 @@ WebPage::WebPage(QObject* parent) :
 
 	setupWebChannel();
 
+	connect(this, &QWebEnginePage::loadStarted, this, [this]()
+	{
+		m_loadTimer.start();
+		m_hasModifiedForms = false;
+		m_loadStopped = false;
+	});
 	connect(this, &QWebEnginePage::loadProgress, this, &WebPage::progress);
 	connect(this, &QWebEnginePage::loadFinished, this, &WebPage::finished);
+	connect(this, &QWebEnginePage::loadFinished, this, [this](bool ok)
+	{
+		HttpsUpgradeInterceptor* httpsUpgrade{Application::instance()->networkManager()->httpsUpgradeInterceptor()};
+
+		if (m_loadStopped) {
+			httpsUpgrade->navigationStopped(requestedUrl());
+			return;
+		}
+
+		// A navigation upgraded to https that failed is done again over http. The url of a failed load may
+		// still be the one of the previous page, pending upgrades are found from the requested one
+		const QUrl fallbackUrl{httpsUpgrade->navigationFinished(requestedUrl(), url(), ok)};
+
+		if (!fallbackUrl.isEmpty())
+			load(fallbackUrl);
+	});
 	connect(this, &QWebEnginePage::urlChanged, this, &WebPage::urlChanged);
 	connect(this, &QWebEnginePage::featurePermissionRequested, this, &WebPage::featurePermissionRequested);
 	connect(this, &QWebEnginePage::windowCloseRequested, this, &WebPage::windowCloseRequested);
@@ -127,6 +150,22 @@ WebView* WebPage::view() const
 	return static_cast<WebView*>(QWebEnginePage::view());
 }
 
+void WebPage::triggerAction(WebAction action, bool checked)
+{
+	if (action == Stop)
+		m_loadStopped = true;
+
+	QWebEnginePage::triggerAction(action, checked);
+}
+
+void WebPage::checkModifiedForms()
+{
+	runJavaScript(Scripts::hasModifiedForms(), QWebEngineScript::ApplicationWorld, [this](const QVariant& res)
+	{
+		m_hasModifiedForms = res.toBool();
+	});
+}
+
 QVariant WebPage::executeJavaScript(const QString& scriptSrc, quint32 worldId, int timeout)
 {
 	QPointer<QEventLoop> loop{new QEventLoop};
@@ -173,6 +212,8 @@ void WebPage::javaScriptAlert(const QUrl& securityOrigin, const QString& msg)
 {
 	Q_UNUSED(securityOrigin)
 
+	++m_javaScriptDialogs;
+
 	if (m_blockAlerts || m_runningLoop)
 		return;
 
@@ -191,6 +232,41 @@ void WebPage::javaScriptAlert(const QUrl& securityOrigin, const QString& msg)
 	m_blockAlerts = dialog.isChecked();
 }
 
+bool WebPage::javaScriptConfirm(const QUrl& securityOrigin, const QString& msg)
+{
+	++m_javaScriptDialogs;
+
+	return QWebEnginePage::javaScriptConfirm(securityOrigin, msg);
+}
+
+bool WebPage::javaScriptPrompt(const QUrl& securityOrigin, const QString& msg, const QString& defaultValue,
+							   QString* result)
+{
+	++m_javaScriptDialogs;
+
+	return QWebEnginePage::javaScriptPrompt(securityOrigin, msg, defaultValue, result);
+}
+
+void WebPage::javaScriptConsoleMessage(JavaScriptConsoleMessageLevel level, const QString& message, int lineNumber,
+									   const QString& sourceID)
+{
+	++m_consoleMessages;
+
+	if (level == ErrorMessageLevel)
+		++m_scriptErrors;
+
+	QWebEnginePage::javaScriptConsoleMessage(level, message, lineNumber, sourceID);
+}
+
+qint64 WebPage::renderProcessId() const
+{
+#if QT_VERSION >= QT_VERSION_CHECK(5, 15, 0)
+	return renderProcessPid();
+#else
+	return -1;
+#endif
+}
+
 void WebPage::setJavaScriptEnable(bool enabled)
 {
 	settings()->setAttribute(QWebEngineSettings::JavascriptEnabled, enabled);
@@ -237,6 +313,12 @@ void WebPage::finished()
 {
 	progress(100);
 
+	if (m_loadTimer.isValid()) {
+		m_lastLoadTime = m_loadTimer.elapsed();
+		m_loadTimer.invalidate();
+		++m_loadCount;
+	}
+
 	if (m_adjustingSheduled) {
 		m_adjustingSheduled = false;
 		setZoomFactor(zoomFactor() + 1);
@@ -34,6 +34,7 @@
 #include <QVariant>
 
 #include <QEventLoop>
+#include <QElapsedTimer>
 
 #include "Password/PasswordManager.hpp"
 
@@ -53,6 +54,8 @@ public:
 
 	WebView* view() const;
 
+	void triggerAction(WebAction action, bool checked = false) Q_DECL_OVERRIDE;
+
 	QVariant executeJavaScript(const QString& scriptSrc, quint32 worldId = QWebEngineScript::MainWorld,
 							   int timeout = 500);
 
@@ -63,6 +66,11 @@ public:
 	void setScrollPosition(const QPointF& pos);
 
 	void javaScriptAlert(const QUrl& securityOrigin, const QString& msg) Q_DECL_OVERRIDE;
+	bool javaScriptConfirm(const QUrl& securityOrigin, const QString& msg) Q_DECL_OVERRIDE;
+	bool javaScriptPrompt(const QUrl& securityOrigin, const QString& msg, const QString& defaultValue,
+						  QString* result) Q_DECL_OVERRIDE;
+	void javaScriptConsoleMessage(JavaScriptConsoleMessageLevel level, const QString& message, int lineNumber,
+								  const QString& sourceID) Q_DECL_OVERRIDE;
 
 	void setJavaScriptEnable(bool enabled);
 
@@ -73,6 +81,19 @@ public:
 	void setupWebChannel();
 
 	static QString setCSS(const QString& css);
+
+	// Resource usage counters, sampled by the tabs metrics collector
+	qint64 renderProcessId() const;
+	int loadCount() const { return m_loadCount; }
+	qint64 lastLoadTime() const { return m_lastLoadTime; }
+	int javaScriptDialogsCount() const { return m_javaScriptDialogs; }
+	int consoleMessagesCount() const { return m_consoleMessages; }
+	int scriptErrorsCount() const { return m_scriptErrors; }
+
+	// Result of the last checkModifiedForms(), reset when a new page starts loading
+	bool hasModifiedForms() const { return m_hasModifiedForms; }
+	void checkModifiedForms();
+
 signals:
 	void privacyChanged(bool status);
 
@@ -104,6 +125,15 @@ private:
 	bool m_secureStatus{false};
 	bool m_adjustingSheduled{false};
 
+	QElapsedTimer m_loadTimer{};
+	int m_loadCount{0};
+	qint64 m_lastLoadTime{-1}; // In ms
+	int m_javaScriptDialogs{0};
+	int m_consoleMessages{0};
+	int m_scriptErrors{0};
+	bool m_hasModifiedForms{false};
+	bool m_loadStopped{false};
+
 };
 
 }
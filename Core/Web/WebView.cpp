@@ -31,7 +31,6 @@
 #include <QUrl>
 #include <QUrlQuery>
 
-#include <QSettings>
 #include <QAction>
 
 #include <QMenu>
@@ -48,6 +47,8 @@
 
 #include "Plugins/PluginProxy.hpp"
 
+#include "Utils/SettingsCache.hpp"
+
 namespace Sn {
 
 bool WebView::isUrlValide(const QUrl& url)
@@ -97,8 +98,7 @@ WebView::WebView(QWidget* parent) :
 	connect(this, &QWebEngineView::loadFinished, this, &WebView::sLoadFinished);
 	connect(this, &QWebEngineView::urlChanged, this, &WebView::sUrlChanged);
 
-	QSettings settings{};
-	m_currentZoomLevel = settings.value("Web-Settings/defaultZoomLevel", WebView::zoomLevels().indexOf(100)).toInt();
+	m_currentZoomLevel = SettingsCache::instance()->defaultZoomLevel();
 
 	setAcceptDrops(true);
 	installEventFilter(this);
@@ -354,8 +354,7 @@ void WebView::zoomOut()
 
 void WebView::zoomReset()
 {
-	QSettings settings{};
-	int defaultZoomLevel{settings.value("Web-Settings/defaultZoomLevel", zoomLevels().indexOf(100)).toInt()};
+	int defaultZoomLevel{SettingsCache::instance()->defaultZoomLevel()};
 
 	if (m_currentZoomLevel != defaultZoomLevel) {
 		m_currentZoomLevel = defaultZoomLevel;
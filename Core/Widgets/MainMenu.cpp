@@ -43,6 +43,7 @@
 #include "Cookies/CookieManager.hpp"
 
 #include "Widgets/AboutDialog.hpp"
+#include "Widgets/TaskManagerDialog.hpp"
 #include "Widgets/HelpUsDialog.hpp"
 #include "Widgets/TitleBar.hpp"
 #include "Widgets/SiteInfo.hpp"
@@ -122,6 +123,7 @@ MainMenu::MainMenu(TabWidget* tabWidget, QWidget* parent) :
 	QAction
 		* showCookiesManagerAction = createAction("ShowCookiesManager", m_toolsMenu, QIcon(),
 		                                          tr("&Cookies Manager"));
+	QAction* showTaskManagerAction = createAction("ShowTaskManager", m_toolsMenu, QIcon(), tr("&Task Manager"));
 	addSeparator();
 	QAction* showSettingsAction = createAction("ShowSettings",
 	                                           this,
@@ -152,6 +154,7 @@ MainMenu::MainMenu(TabWidget* tabWidget, QWidget* parent) :
 	connect(showSiteInfoAction, &QAction::triggered, this, &MainMenu::showSiteInfo);
 	connect(showDownloadManagerAction, &QAction::triggered, this, &MainMenu::showDownloadManager);
 	connect(showCookiesManagerAction, &QAction::triggered, this, &MainMenu::showCookiesManager);
+	connect(showTaskManagerAction, &QAction::triggered, this, &MainMenu::showTaskManager);
 
 	connect(showSettingsAction, &QAction::triggered, this, &MainMenu::showSettings);
 	connect(showAboutSieloAction, &QAction::triggered, this, &MainMenu::showAboutSielo);
@@ -289,6 +292,12 @@ void MainMenu::showCookiesManager()
 	dialog->show();
 }
 
+void MainMenu::showTaskManager()
+{
+	TaskManagerDialog* dialog{new TaskManagerDialog()};
+	dialog->show();
+}
+
 void MainMenu::showSiteInfo()
 {
 	if (m_tabWidget && SiteInfo::canShowSiteInfo(m_tabWidget->weTab()->url())) {
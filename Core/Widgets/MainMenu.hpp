@@ -73,6 +73,7 @@ private slots:
 	// Tools menu
 	void showDownloadManager();
 	void showCookiesManager();
+	void showTaskManager();
 	void showSiteInfo();
 
 	void showSettings();
@@ -26,17 +26,16 @@
 
 #include <QSettings>
 
-#include <QProcess>
-#include <QTimer>
-
 #include <QMessageBox>
 #include <QColorDialog>
 #include <QFileDialog>
 
 #include <QDir>
 #include <QVariant>
+#include <QPixmap>
 
 #include "Utils/RegExp.hpp"
+#include "Utils/ThemeArchive.hpp"
 
 #include "Widgets/Preferences/PreferencesDialog.hpp"
 
@@ -197,46 +196,39 @@ void AppearancePage::openGallery()
 
 void AppearancePage::addTheme()
 {
-#if defined(Q_OS_WIN)
-	QString compilerName = "sielo-compiler.exe";
-#else
-	QString compilerName = "sielo-compiler";
-#endif
-	if (!QFile(QDir(QCoreApplication::applicationDirPath()).absolutePath() + QLatin1Char('/') + compilerName)
-			.exists()) {
-		QMessageBox::critical(this,
-							  tr("Error"),
-							  tr("Can't decompile theme... Be sure compiler is with Sielo main exe, else move it manually or update/reinstall the browser."));
-		return;
-	}
-
 	QString themeFile{QFileDialog::getOpenFileName(this, tr("Open a theme"), QString(), "Themes (*.snthm)")};
 
 	if (themeFile.isEmpty())
 		return;
 
-	QFileInfo themeInfo{Application::paths()[Application::P_Themes] + QLatin1Char('/')
-						+ QFileInfo(themeFile).baseName()
-						+ QLatin1String("/main.sss")};
+	if (!ThemeArchive(themeFile).isValid()) {
+		QMessageBox::critical(this, tr("Error"), tr("This file is not a valid Sielo theme."));
+		return;
+	}
+
+	// Archives are installed as is, the browser reads them without decompiling them
+	QString themePath{Application::paths()[Application::P_Themes] + QLatin1Char('/') + QFileInfo(themeFile).baseName()};
+	QString archivePath{themePath + QLatin1String(".snthm")};
+
+	if (QFileInfo(themeFile).absoluteFilePath() == QFileInfo(archivePath).absoluteFilePath())
+		return;
 
-	if (themeInfo.exists()) {
+	if (QFileInfo(themePath + QLatin1String("/main.sss")).exists() || QFile::exists(archivePath)) {
 		QMessageBox::warning(this,
 							 tr("Theme exist"),
 							 tr("The theme already exist and is going to be update with the new version."));
-		QDir(Application::paths()[Application::P_Themes] + QLatin1Char('/') + QFileInfo(themeFile).baseName())
-				.removeRecursively();
+		QDir(themePath).removeRecursively();
+		QFile::remove(archivePath);
 	}
 
-	QStringList decompileArgs{};
-	decompileArgs << "decompile" << themeFile
-				  << Application::instance()->paths()[Application::P_Themes] + QLatin1Char('/')
-					 + QFileInfo(themeFile).baseName() << "Theme successfully decompiled";
+	QDir().mkpath(Application::paths()[Application::P_Themes]);
 
-	QProcess::execute(QDir(QCoreApplication::applicationDirPath()).absolutePath() + QLatin1Char('/') + compilerName,
-					  decompileArgs);
-
-	QTimer::singleShot(500, this, &AppearancePage::loadSettings);
+	if (!QFile::copy(themeFile, archivePath)) {
+		QMessageBox::critical(this, tr("Error"), tr("Failed to install the theme."));
+		return;
+	}
 
+	loadSettings();
 }
 
 void AppearancePage::getColor()
@@ -263,24 +255,43 @@ void AppearancePage::useRealToolBarChanged(bool enabled)
 	m_hideBookmarksHistoryActionsByDefault->setEnabled(m_useRealToolBar->isChecked());
 }
 
-AppearancePage::Theme AppearancePage::parseTheme(const QString& path, const QString& name)
+AppearancePage::Theme AppearancePage::parseTheme(const QString& path, const QString& name, const ThemeArchive* archive)
 {
 	Theme info{};
 
-	if (!QFile(path + "main.sss").exists() || !QFile(path + "theme.info").exists()) {
+	// Files are read from the theme directory, or from the theme archive
+	auto themeFileExists = [&](const QString& fileName)
+	{
+		return archive ? archive->contains(fileName) : QFile(path + fileName).exists();
+	};
+	auto readThemeFile = [&](const QString& fileName)
+	{
+		return archive ? QString::fromUtf8(archive->read(fileName)) : Application::instance()->readFile(path + fileName);
+	};
+
+	if ((archive && !archive->isValid()) || !themeFileExists("main.sss") || !themeFileExists("theme.info")) {
 		info.isValid = false;
 		return info;
 	}
 
-	if (QFile(path + "theme.png").exists())
-		info.icon = QIcon(path + "theme.png");
-	else
+	if (themeFileExists("theme.png")) {
+		if (archive) {
+			QPixmap icon{};
+			icon.loadFromData(archive->read("theme.png"));
+			info.icon = QIcon(icon);
+		}
+		else {
+			info.icon = QIcon(path + "theme.png");
+		}
+	}
+	else {
 		info.icon = Application::getAppIcon("webpage");
+	}
 
-	if (QFile(path + "theme.license").exists())
-		info.license = Application::instance()->readFile(path + "theme.license");
+	if (themeFileExists("theme.license"))
+		info.license = readThemeFile("theme.license");
 
-	QString themeInfo{Application::instance()->readFile(path + "theme.info")};
+	QString themeInfo{readThemeFile("theme.info")};
 
 	RegExp regExp{"Name:(.*)\\n"};
 	regExp.setMinimal(true);
@@ -351,10 +362,19 @@ void AppearancePage::loadSettings()
 	m_themeList->clear();
 
 	QDir dir{Application::instance()->paths()[Application::P_Themes]};
-	QStringList list = dir.entryList(QDir::AllDirs | QDir::NoDotAndDotDot);
+	QStringList list = Application::installedThemes();
 
 			foreach (const QString& name, list) {
-			Theme themeInfo = parseTheme(dir.absoluteFilePath(name) + QLatin1Char('/'), name);
+			Theme themeInfo{};
+			QString themePath{Application::themePath(name)};
+
+			if (!themePath.isEmpty()) {
+				themeInfo = parseTheme(themePath + QLatin1Char('/'), name);
+			}
+			else {
+				ThemeArchive archive{dir.absoluteFilePath(name + QLatin1String(".snthm"))};
+				themeInfo = parseTheme(QString(), name, &archive);
+			}
 
 			if (!themeInfo.isValid)
 				continue;
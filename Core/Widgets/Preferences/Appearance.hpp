@@ -45,6 +45,7 @@
 
 namespace Sn {
 class PreferencesDialog;
+class ThemeArchive;
 
 class AppearancePage : public QWidget {
 Q_OBJECT
@@ -80,7 +81,7 @@ private:
 		QString license{};
 	};
 
-	Theme parseTheme(const QString& path, const QString& name);
+	Theme parseTheme(const QString& path, const QString& name, const ThemeArchive* archive = nullptr);
 
 	void setupUI();
 
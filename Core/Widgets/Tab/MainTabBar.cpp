@@ -379,7 +379,7 @@ void MainTabBar::contextMenuEvent(QContextMenuEvent* event)
 		if (!webTab)
 			return;
 
-		if (m_window->webView(m_clickedTab)->isLoading())
+		if (webTab->isLoading())
 			menu.addAction(Application::getAppIcon("stop"),
 						   tr("&Stop Tab"),
 						   this,
@@ -549,10 +549,10 @@ void MainTabBar::dropEvent(QDropEvent* event)
 		WebTab* webTab{sourceTabWidget->weTab(index)};
 		int tabCount = sourceTabWidget->normalTabsCount();
 
-		if (Application::instance()->useTopToolBar())
-			sourceTabWidget->addressBars()->removeWidget(webTab->addressBar());
+		if (webTab && webTab->hasWebView() && sourceTabWidget) {
+			if (Application::instance()->useTopToolBar())
+				sourceTabWidget->addressBars()->removeWidget(webTab->addressBar());
 
-		if (webTab && webTab->webView() && sourceTabWidget) {
 			disconnect(webTab->webView(), &TabbedWebView::wantsCloseTab, sourceTabWidget, &TabWidget::closeTab);
 			disconnect(webTab->webView(), SIGNAL(urlChanged(QUrl)), sourceTabWidget, SIGNAL(changed()));
 		}
@@ -589,7 +589,7 @@ void MainTabBar::dropEvent(QDropEvent* event)
 																				 Application::NTT_SelectedTabAtEnd);
 		}
 		else {
-			WebTab* tab{m_window->webView(index)->webTab()};
+			WebTab* tab{m_tabWidget->weTab(index)};
 			if (tab->isRestored())
 				tab->webView()->load(mime->urls()[0]);
 		}
@@ -41,7 +41,6 @@ TabIcon::Data* TabIcon::s_data = Q_NULLPTR;
 TabIcon::TabIcon(QWidget* parent) :
 	QWidget(parent),
 	m_tab(nullptr),
-	m_currentFrame(0),
 	m_animationRunning(false),
 	m_audioIconDisplayed(false)
 {
@@ -55,28 +54,44 @@ TabIcon::TabIcon(QWidget* parent) :
 			Application::getAppIcon("audioplaying", "tabs");
 		s_data->audioMutedPixmap =
 			Application::getAppIcon("audiomuted", "tabs");
-	}
 
-	m_updateTimer = new QTimer(this);
-	m_updateTimer->setInterval(ANIMATION_INTERVAL);
+		s_data->animationTimer = new QTimer;
+		s_data->animationTimer->setInterval(ANIMATION_INTERVAL);
+
+		QObject::connect(s_data->animationTimer, &QTimer::timeout, &TabIcon::advanceAnimation);
+	}
 
 	m_hideTimer = new QTimer(this);
 	m_hideTimer->setInterval(250);
 
-	connect(m_updateTimer, &QTimer::timeout, this, &TabIcon::updateAnimationFrame);
 	connect(m_hideTimer, &QTimer::timeout, this, &TabIcon::hide);
 
 	resize(16, 16);
 }
 
+TabIcon::~TabIcon()
+{
+	s_data->animatedIcons.remove(this);
+
+	if (s_data->animatedIcons.isEmpty())
+		s_data->animationTimer->stop();
+}
+
 void TabIcon::setWebTab(WebTab* tab)
 {
 	m_tab = tab;
 
-	connect(m_tab->webView(), &TabbedWebView::loadStarted, this, &TabIcon::showLoadingAnimation);
-	connect(m_tab->webView(), &TabbedWebView::loadFinished, this, &TabIcon::hideLoadingAnimation);
-	connect(m_tab->webView(), &TabbedWebView::iconChanged, this, &TabIcon::updateIcon);
-	connect(m_tab->webView()->page(), &WebPage::recentlyAudibleChanged, this, &TabIcon::updateAudioIcon);
+	if (!m_tab->hasWebView()) {
+		updateIcon();
+		return;
+	}
+
+	// Called again when the tab page is replaced, so connections must stay unique
+	connect(m_tab->webView(), &TabbedWebView::loadStarted, this, &TabIcon::showLoadingAnimation, Qt::UniqueConnection);
+	connect(m_tab->webView(), &TabbedWebView::loadFinished, this, &TabIcon::hideLoadingAnimation, Qt::UniqueConnection);
+	connect(m_tab->webView(), &TabbedWebView::iconChanged, this, &TabIcon::updateIcon, Qt::UniqueConnection);
+	connect(m_tab->webView()->page(), &WebPage::recentlyAudibleChanged, this, &TabIcon::updateAudioIcon,
+			Qt::UniqueConnection);
 
 	updateIcon();
 }
@@ -95,17 +110,24 @@ void TabIcon::updateIcon()
 
 void TabIcon::showLoadingAnimation()
 {
-	m_currentFrame = 0;
+	m_animationRunning = true;
+	s_data->animatedIcons.insert(this);
 
-	updateAnimationFrame();
+	if (!s_data->animationTimer->isActive())
+		s_data->animationTimer->start();
+
+	update();
 	show();
 }
 
 void TabIcon::hideLoadingAnimation()
 {
 	m_animationRunning = false;
+	s_data->animatedIcons.remove(this);
+
+	if (s_data->animatedIcons.isEmpty())
+		s_data->animationTimer->stop();
 
-	m_updateTimer->stop();
 	updateIcon();
 }
 
@@ -125,15 +147,16 @@ void TabIcon::updateAudioIcon(bool recentlyAudible)
 	update();
 }
 
-void TabIcon::updateAnimationFrame()
+void TabIcon::advanceAnimation()
 {
-	if (!m_animationRunning) {
-		m_updateTimer->start();
-		m_animationRunning = true;
-	}
+	s_data->currentFrame = (s_data->currentFrame + 1) % s_data->framesCount;
 
-	update();
-	m_currentFrame = (m_currentFrame + 1) % s_data->framesCount;
+	// Requested updates are painted together with the rest of their window, and icons of
+	// hidden tab bars or minimized windows are not repainted at all
+	foreach (TabIcon* icon, s_data->animatedIcons) {
+		if (icon->isVisible() && !icon->window()->isMinimized())
+			icon->update();
+	}
 }
 
 void TabIcon::show()
@@ -185,7 +208,7 @@ void TabIcon::paintEvent(QPaintEvent* event)
 
 	if (m_animationRunning)
 		painter
-			.drawPixmap(r, s_data->animationPixmap, QRect(m_currentFrame * pixmapSize, 0, pixmapSize, pixmapSize));
+			.drawPixmap(r, s_data->animationPixmap, QRect(s_data->currentFrame * pixmapSize, 0, pixmapSize, pixmapSize));
 	else if (m_audioIconDisplayed)
 		painter.drawPixmap(r,
 						   m_tab->isMuted() ? s_data->audioMutedPixmap.pixmap(16) : s_data->audioPlayingPixmap
@@ -31,6 +31,7 @@
 #include <QIcon>
 
 #include <QTimer>
+#include <QSet>
 
 #include <QPaintEvent>
 #include <QMouseEvent>
@@ -43,6 +44,7 @@ Q_OBJECT
 
 public:
 	TabIcon(QWidget* parent = nullptr);
+	~TabIcon();
 
 	void setWebTab(WebTab* tab);
 	void updateIcon();
@@ -55,22 +57,21 @@ private slots:
 	void hideLoadingAnimation();
 
 	void updateAudioIcon(bool recentlyAudible);
-	void updateAnimationFrame();
 
 private:
 	void show();
 	void hide();
 	bool shouldBeVisible() const;
 
+	static void advanceAnimation();
+
 	void paintEvent(QPaintEvent* event);
 	void mousePressEvent(QMouseEvent* event);
 
 	WebTab* m_tab{nullptr};
-	QTimer* m_updateTimer{nullptr};
 	QTimer* m_hideTimer{nullptr};
 	QPixmap m_sitePixmap{};
 
-	int m_currentFrame{0};
 	bool m_animationRunning{false};
 	bool m_audioIconDisplayed{false};
 
@@ -79,6 +80,11 @@ private:
 		QPixmap animationPixmap{};
 		QIcon audioPlayingPixmap{};
 		QIcon audioMutedPixmap{};
+
+		// One clock drives the loading animation of every tab
+		QTimer* animationTimer{nullptr};
+		QSet<TabIcon*> animatedIcons{};
+		int currentFrame{0};
 	};
 
 	static Data* s_data;
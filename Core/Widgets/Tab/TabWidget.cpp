@@ -48,6 +48,7 @@
 #include "Web/WebView.hpp"
 #include "Web/WebInspector.hpp"
 #include "Web/Tab/TabbedWebView.hpp"
+#include "Web/Tab/TabsLifecycleManager.hpp"
 
 #include "Widgets/NavigationBar.hpp"
 #include "Widgets/MainMenu.hpp"
@@ -235,38 +236,9 @@ void TabWidget::loadSettings()
 	updateClosedTabsButton();
 }
 
-QByteArray TabWidget::saveState()
-{
-	QVector<WebTab::SavedTab> tabList;
-
-	for (int i{0}; i < count(); ++i) {
-		WebTab* webTab{weTab(i)};
-
-		if (!webTab)
-			continue;
-
-		WebTab::SavedTab tab{webTab};
-		tabList.append(tab);
-	}
-
-	QByteArray data;
-	QDataStream stream{&data, QIODevice::WriteOnly};
-
-	stream << m_homeUrl;
-
-	int tabListCount = tabList.count();
-	stream << tabListCount;
-
-	foreach (const WebTab::SavedTab& tab, tabList) stream << tab;
-
-	stream << currentIndex();
-
-	return data;
-}
-
 void TabWidget::save()
 {
-	Application::instance()->saveSession();
+	Application::instance()->checkpointSession();
 }
 
 bool TabWidget::restoreState(const QVector<WebTab::SavedTab>& tabs, int currentTab, const QUrl& homeUrl)
@@ -276,8 +248,23 @@ bool TabWidget::restoreState(const QVector<WebTab::SavedTab>& tabs, int currentT
 	if (m_homeUrl.isEmpty())
 		m_homeUrl = m_window->homePageUrl();
 
+	QSettings settings{};
+	const bool loadOnActivation{settings.value("Web-Settings/LoadTabsOnActivation", true).toBool()};
+
 	for (WebTab::SavedTab tab : tabs) {
-		int index{addView(QUrl(), Application::NTT_CleanSelectedTab, false, tab.isPinned)};
+		int index{-1};
+
+		// Tabs loaded on activation only get a placeholder until they are shown
+		if (loadOnActivation && !tab.isPinned && tab.isValide()) {
+			WebTab* webTab{new WebTab(m_window, tab)};
+
+			index = insertTab(count(), webTab, QString(), false);
+			webTab->attach(this);
+			webTab->setMuted(m_isMutted);
+		}
+		else
+			index = addView(QUrl(), Application::NTT_CleanSelectedTab, false, tab.isPinned);
+
 		weTab(index)->restoreTab(tab);
 
 		if (tab.isPinned)
@@ -328,13 +315,16 @@ void TabWidget::currentTabChanged(int index)
 
 	WebTab* currentTab{weTab(index)};
 	WebTab* oldTab{weTab()};
-	WebView* currentWebView = currentTab->webView();
+
+	// Placeholder tabs get their web view when they are activated
+	WebView* currentWebView = currentTab->ensureWebView();
 
 	if (currentWebView->wasLoaded()) {
 		WebInspector::pushView(currentWebView);
 	}
 
-	disconnect(oldTab->webView()->page(), &WebPage::fullScreenRequested, this, &TabWidget::fullScreenRequested);
+	if (oldTab && oldTab->hasWebView())
+		disconnect(oldTab->webView()->page(), &WebPage::fullScreenRequested, this, &TabWidget::fullScreenRequested);
 
 	connect(currentTab->webView()->page(), &WebPage::fullScreenRequested, this, &TabWidget::fullScreenRequested);
 
@@ -350,6 +340,10 @@ void TabWidget::currentTabChanged(int index)
 
 	m_window->currentTabChanged(oldTab);
 
+	// Switching tabs may push the loaded tabs over the memory budget
+	if (TabsLifecycleManager* lifecycleManager = Application::instance()->tabsLifecycleManager())
+		lifecycleManager->scheduleCheck();
+
 	if (m_tabsSpaceType != Application::TST_Web && currentTab->addressBar()) {
 		/*currentTab->addressBar()->setEnabled(false);
 		currentTab->addressBar()->setText("sielo:inspector");
@@ -465,8 +459,7 @@ int TabWidget::addView(const LoadRequest& request, const QString& title, const A
 
 	WebTab* webTab{new WebTab(m_window)};
 	webTab->addressBar()->showUrl(url);
-	if (Application::instance()->useTopToolBar())
-		m_addressBars->addWidget(webTab->addressBar());
+	setupWebView(webTab);
 
 	int index{insertTab(position == -1 ? count() : position, webTab, QString(), pinned)};
 
@@ -481,13 +474,6 @@ int TabWidget::addView(const LoadRequest& request, const QString& title, const A
 	else
 		m_lastBackgroundTabIndex = index;
 
-	connect(webTab->webView(), &TabbedWebView::wantsCloseTab, this, &TabWidget::closeTab);
-	connect(webTab->webView(), SIGNAL(urlChanged(QUrl)), this, SIGNAL(changed()));
-	connect(webTab->webView(), &WebView::urlChanged, this, [this](const QUrl& url) {
-		if (url != m_urlOnNewTab)
-			m_currentTabFresh = false;
-	});
-
 	if (url.isValid() && url != request.url()) {
 		LoadRequest req{request};
 		req.setUrl(url);
@@ -508,18 +494,28 @@ int TabWidget::addView(const LoadRequest& request, const QString& title, const A
 
 int TabWidget::addView(WebTab* tab)
 {
-	if (Application::instance()->useTopToolBar())
-		m_addressBars->addWidget(tab->addressBar());
-
 	int index{addTab(tab, QString())};
 	tab->attach(this);
 
-	connect(tab->webView(), &TabbedWebView::wantsCloseTab, this, &TabWidget::closeTab);
-	connect(tab->webView(), SIGNAL(urlChanged(QUrl)), this, SIGNAL(changed()));
+	if (tab->hasWebView())
+		setupWebView(tab);
 
 	return index;
 }
 
+void TabWidget::setupWebView(WebTab* tab)
+{
+	if (Application::instance()->useTopToolBar())
+		m_addressBars->addWidget(tab->addressBar());
+
+	connect(tab->webView(), &TabbedWebView::wantsCloseTab, this, &TabWidget::closeTab, Qt::UniqueConnection);
+	connect(tab->webView(), SIGNAL(urlChanged(QUrl)), this, SIGNAL(changed()), Qt::UniqueConnection);
+	connect(tab->webView(), &WebView::urlChanged, this, [this](const QUrl& url) {
+		if (url != m_urlOnNewTab)
+			m_currentTabFresh = false;
+	});
+}
+
 void TabWidget::addTabFromClipboard()
 {
 	QString selectionClipboard{QApplication::clipboard()->text(QClipboard::Selection)};
@@ -551,16 +547,19 @@ void TabWidget::closeTab(int index)
 	if (!webTab || !validIndex(index))
 		return;
 
-	TabbedWebView* webView{webTab->webView()};
-
-	if (webView->url().toString() != QLatin1String("sielo:restore"))
+	if (webTab->url().toString() != QLatin1String("sielo:restore"))
 		m_closedTabsManager->saveTab(webTab, index);
 
-	if (Application::instance()->useTopToolBar())
-		m_addressBars->removeWidget(webView->webTab()->addressBar());
+	// Placeholder tabs never had a web view, don't create one just to close them
+	if (webTab->hasWebView()) {
+		TabbedWebView* webView{webTab->webView()};
 
-	disconnect(webView, &TabbedWebView::wantsCloseTab, this, &TabWidget::closeTab);
-	disconnect(webView, SIGNAL(urlChanged(QUrl)), this, SIGNAL(changed()));
+		if (Application::instance()->useTopToolBar())
+			m_addressBars->removeWidget(webTab->addressBar());
+
+		disconnect(webView, &TabbedWebView::wantsCloseTab, this, &TabWidget::closeTab);
+		disconnect(webView, SIGNAL(urlChanged(QUrl)), this, SIGNAL(changed()));
+	}
 
 	m_lastBackgroundTabIndex = -1;
 
@@ -586,12 +585,12 @@ void TabWidget::requestCloseTab(int index)
 	if (!webTab || !validIndex(index))
 		return;
 
-	TabbedWebView* webView{webTab->webView()};
-
 	//TODO: block close of restore tab
 
 	if (count() == 1 && m_window->tabWidgetsCount() == 1) {
 		if (m_dontCloseWithOneTab) {
+			TabbedWebView* webView{webTab->webView()};
+
 			if (webView->url() == m_urlOnNewTab)
 				m_closedTabsManager->takeLastClosedTab();
 			webView->load(m_urlOnNewTab);
@@ -605,7 +604,13 @@ void TabWidget::requestCloseTab(int index)
 		return;
 	}
 
-	webView->triggerPageAction(QWebEnginePage::RequestClose);
+	// Placeholder tabs have no page to ask
+	if (!webTab->hasWebView()) {
+		closeTab(index);
+		return;
+	}
+
+	webTab->webView()->triggerPageAction(QWebEnginePage::RequestClose);
 }
 
 void TabWidget::reloadTab(int index)
@@ -694,11 +699,13 @@ void TabWidget::detachTab(int index)
 	if (webTab->isPinned() || count() == 1)
 		return;
 
-	if (Application::instance()->useTopToolBar())
-		m_addressBars->removeWidget(webTab->addressBar());
+	if (webTab->hasWebView()) {
+		if (Application::instance()->useTopToolBar())
+			m_addressBars->removeWidget(webTab->addressBar());
 
-	disconnect(webTab->webView(), &TabbedWebView::wantsCloseTab, this, &TabWidget::closeTab);
-	disconnect(webTab->webView(), SIGNAL(urlChanged(QUrl)), this, SIGNAL(changed()));
+		disconnect(webTab->webView(), &TabbedWebView::wantsCloseTab, this, &TabWidget::closeTab);
+		disconnect(webTab->webView(), SIGNAL(urlChanged(QUrl)), this, SIGNAL(changed()));
+	}
 
 	webTab->detach();
 
@@ -717,11 +724,13 @@ void TabWidget::detachTabFromDrop(int index)
 	if (nbreOfTabs <= 1 && m_window->tabWidgetsCount() <= 1)
 		return;
 
-	if (Application::instance()->useTopToolBar())
-		m_addressBars->removeWidget(webTab->addressBar());
+	if (webTab->hasWebView()) {
+		if (Application::instance()->useTopToolBar())
+			m_addressBars->removeWidget(webTab->addressBar());
 
-	disconnect(webTab->webView(), &TabbedWebView::wantsCloseTab, this, &TabWidget::closeTab);
-	disconnect(webTab->webView(), SIGNAL(urlChanged(QUrl)), this, SIGNAL(changed()));
+		disconnect(webTab->webView(), &TabbedWebView::wantsCloseTab, this, &TabWidget::closeTab);
+		disconnect(webTab->webView(), SIGNAL(urlChanged(QUrl)), this, SIGNAL(changed()));
+	}
 
 	webTab->detach();
 
@@ -764,7 +773,7 @@ void TabWidget::restoreClosedTab(QObject* obj)
 
 	int index{addView(QUrl(), tab.title, Application::NTT_CleanSelectedTab, false, tab.position)};
 	WebTab* webTab{weTab(index)};
-	webTab->p_restoreTab(tab.url, tab.history, tab.zoomLevel);
+	webTab->p_restoreTab(tab.url, tab.history(), tab.zoomLevel);
 
 	updateClosedTabsButton();
 }
@@ -774,12 +783,12 @@ void TabWidget::restoreAllClosedTabs()
 	if (!m_closedTabsManager->isClosedTabAvailable())
 		return;
 
-	const QLinkedList<ClosedTabsManager::Tab>& closedTabs = m_closedTabsManager->allClosedTab();
+	const QVector<ClosedTabsManager::Tab>& closedTabs = m_closedTabsManager->allClosedTab();
 
 	foreach (const ClosedTabsManager::Tab& tab, closedTabs) {
 		int index{addView(QUrl(), tab.title, Application::NTT_CleanSelectedTab)};
 		WebTab* webTab{weTab(index)};
-		webTab->p_restoreTab(tab.url, tab.history, tab.zoomLevel);
+		webTab->p_restoreTab(tab.url, tab.history(), tab.zoomLevel);
 	}
 
 	clearClosedTabsList();
@@ -918,12 +927,12 @@ void TabWidget::aboutToShowClosedTabsMenu()
 	m_menuClosedTabs->clear();
 
 	int i{0};
-	const QLinkedList<ClosedTabsManager::Tab> closedTabs = closedTabsManager()->allClosedTab();
+	const QVector<ClosedTabsManager::Tab> closedTabs = closedTabsManager()->allClosedTab();
 
 	foreach (const ClosedTabsManager::Tab& tab, closedTabs) {
 		const QString title{tab.title.length() > 40 ? tab.title.left(40) + QLatin1String("...") : tab.title};
 		QAction* action{m_menuClosedTabs->addAction(tab.icon, title, this, SLOT(restoreClosedTab()))};
-		action->setData(++i);
+		action->setData(i++);
 	}
 
 	if (m_menuClosedTabs->isEmpty())
@@ -67,7 +67,6 @@ public:
 
 	void loadSettings();
 
-	QByteArray saveState();
 	void saveButtonState();
 	bool restoreState(const QVector<WebTab::SavedTab>& tabs, int currentTab, const QUrl& homeUrl);
 	void closeRecoveryTab();
@@ -94,6 +93,7 @@ public:
 	NavigationToolBar* navigationToolBar() const { return m_navigationToolBar; }
 	ClosedTabsManager* closedTabsManager() const { return m_closedTabsManager; }
 	QList<WebTab*> allTabs(bool withPinned = true);
+	void setupWebView(WebTab* tab);
 	Application::TabsSpaceType type() const { return m_tabsSpaceType; }
 
 	bool canRestoreTab() const;
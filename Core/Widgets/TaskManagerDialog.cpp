@@ -0,0 +1,233 @@
+/***********************************************************************************
+** MIT License                                                                    **
+**                                                                                **
+** Copyright (c) 2018 Victor DENIS (victordenis01@gmail.com)                      **
+**                                                                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+***********************************************************************************/
+
+#include "TaskManagerDialog.hpp"
+
+#include <QHeaderView>
+#include <QFileDialog>
+#include <QMessageBox>
+#include <QSaveFile>
+#include <QDir>
+
+#include <QJsonObject>
+#include <QJsonArray>
+
+#include "Network/NetworkManager.hpp"
+
+#include "Web/Tab/TabsMetrics.hpp"
+
+#include "Application.hpp"
+
+namespace Sn {
+
+static const int REFRESH_INTERVAL = 1000 * 2;
+
+TaskManagerDialog::TaskManagerDialog(QWidget* parent) :
+		QDialog(parent)
+{
+	QIcon icon = windowIcon();
+	Qt::WindowFlags flags = windowFlags();
+	Qt::WindowFlags helpFlag = Qt::WindowContextHelpButtonHint;
+
+	flags = flags & (~helpFlag);
+	setWindowFlags(flags);
+	setWindowIcon(icon);
+	setAttribute(Qt::WA_DeleteOnClose);
+
+	setupUI();
+
+	m_refreshTimer = new QTimer(this);
+	m_refreshTimer->setInterval(REFRESH_INTERVAL);
+
+	connect(m_refreshTimer, &QTimer::timeout, this, &TaskManagerDialog::refresh);
+	connect(m_refreshTimer, &QTimer::timeout, this, &TaskManagerDialog::refreshRequests);
+	connect(m_exportButton, &QPushButton::clicked, this, &TaskManagerDialog::exportJson);
+	connect(m_closeButtonBox, &QDialogButtonBox::rejected, this, &TaskManagerDialog::close);
+
+	refresh();
+	refreshRequests();
+	m_refreshTimer->start();
+}
+
+TaskManagerDialog::~TaskManagerDialog()
+{
+	// Empty
+}
+
+void TaskManagerDialog::refresh()
+{
+	const QVector<TabsMetrics::Sample> samples{Application::instance()->tabsMetrics()->sample()};
+
+	m_tabsList->clear();
+
+	foreach (const TabsMetrics::Sample& sample, samples) {
+		QTreeWidgetItem* item{new QTreeWidgetItem(m_tabsList)};
+
+		QString state{tr("Loaded")};
+
+		if (!sample.loaded)
+			state = tr("Discarded");
+		else if (sample.frozen)
+			state = tr("Frozen");
+
+		item->setText(0, sample.title.isEmpty() ? sample.url.toString() : sample.title);
+		item->setToolTip(0, sample.url.toString());
+		item->setText(1, state);
+		item->setText(2, sample.processId > 0 ? QString::number(sample.processId) : QString());
+		item->setText(3, sample.memory >= 0 ? tr("%1 MB").arg(sample.memory / (1024 * 1024)) : QString());
+		item->setText(4, sample.lastLoadTime >= 0 ? tr("%1 ms").arg(sample.lastLoadTime) : QString());
+		item->setText(5, QString::number(sample.blockedRequests));
+		item->setText(6, QString::number(sample.javaScriptDialogs));
+		item->setText(7, QString("%1 (%2)").arg(sample.consoleMessages).arg(sample.scriptErrors));
+	}
+}
+
+void TaskManagerDialog::refreshRequests()
+{
+	const QJsonObject statistics{Application::instance()->networkManager()->interceptionStatistics()};
+
+	m_interceptorsList->clear();
+	m_resourceTypesList->clear();
+
+	QJsonArray interceptors{statistics.value("interceptors").toArray()};
+	QJsonObject total{statistics.value("total").toObject()};
+
+	total.insert("name", tr("All interceptors"));
+	interceptors.prepend(total);
+
+	foreach (const QJsonValue& value, interceptors) {
+		const QJsonObject interceptor{value.toObject()};
+		QTreeWidgetItem* item{new QTreeWidgetItem(m_interceptorsList)};
+
+		item->setText(0, interceptor.value("name").toString());
+		item->setText(1, QString::number(interceptor.value("count").toDouble(), 'f', 0));
+		item->setText(2, interceptor.contains("blocked") ? QString::number(interceptor.value("blocked").toDouble(), 'f', 0)
+													   : QString());
+		item->setText(3, tr("%1 µs").arg(interceptor.value("p50").toDouble(), 0, 'f', 1));
+		item->setText(4, tr("%1 µs").arg(interceptor.value("p99").toDouble(), 0, 'f', 1));
+		item->setText(5, tr("%1 µs").arg(interceptor.value("max").toDouble(), 0, 'f', 1));
+	}
+
+	foreach (const QJsonValue& value, statistics.value("resourceTypes").toArray()) {
+		const QJsonObject resourceType{value.toObject()};
+		QTreeWidgetItem* item{new QTreeWidgetItem(m_resourceTypesList)};
+
+		item->setText(0, resourceType.value("type").toString());
+		item->setText(1, QString::number(resourceType.value("allowed").toDouble(), 'f', 0));
+		item->setText(2, QString::number(resourceType.value("blocked").toDouble(), 'f', 0));
+	}
+}
+
+void TaskManagerDialog::exportJson()
+{
+	const QString fileName{
+		QFileDialog::getSaveFileName(this, tr("Export Metrics"), QDir::homePath() + "/sielo-tabs.json",
+									 tr("JSON files (*.json)"))
+	};
+
+	if (fileName.isEmpty())
+		return;
+
+	QSaveFile file{fileName};
+
+	if (!file.open(QIODevice::WriteOnly)) {
+		QMessageBox::critical(this, tr("Error"), tr("Failed to open %1 for writing").arg(fileName));
+		return;
+	}
+
+	QJsonObject metrics{TabsMetrics::toJson(Application::instance()->tabsMetrics()->sample()).object()};
+	metrics.insert("requests", Application::instance()->networkManager()->interceptionStatistics());
+
+	file.write(QJsonDocument(metrics).toJson());
+
+	if (!file.commit())
+		QMessageBox::critical(this, tr("Error"), tr("Failed to write %1").arg(fileName));
+}
+
+void TaskManagerDialog::setupUI()
+{
+	resize(760, 420);
+	setWindowTitle(tr("Task Manager"));
+
+	m_layout = new QVBoxLayout(this);
+	m_buttonsLayout = new QHBoxLayout();
+
+	m_pages = new QTabWidget(this);
+
+	m_tabsList = new QTreeWidget(m_pages);
+	m_tabsList->setRootIsDecorated(false);
+	m_tabsList->setSortingEnabled(false);
+	m_tabsList->setHeaderLabels(QStringList()
+									<< tr("Tab")
+									<< tr("State")
+									<< tr("Process")
+									<< tr("Memory")
+									<< tr("Load Time")
+									<< tr("Blocked on Site")
+									<< tr("Dialogs")
+									<< tr("Console (Errors)"));
+	m_tabsList->header()->setSectionResizeMode(0, QHeaderView::Stretch);
+	m_tabsList->header()->setStretchLastSection(false);
+
+	m_requestsPage = new QWidget(m_pages);
+	m_requestsLayout = new QVBoxLayout(m_requestsPage);
+
+	m_interceptorsList = new QTreeWidget(m_requestsPage);
+	m_interceptorsList->setRootIsDecorated(false);
+	m_interceptorsList->setHeaderLabels(QStringList()
+											<< tr("Interceptor")
+											<< tr("Requests")
+											<< tr("Blocked")
+											<< tr("Median")
+											<< tr("99th Percentile")
+											<< tr("Max"));
+	m_interceptorsList->header()->setSectionResizeMode(0, QHeaderView::Stretch);
+	m_interceptorsList->header()->setStretchLastSection(false);
+
+	m_resourceTypesList = new QTreeWidget(m_requestsPage);
+	m_resourceTypesList->setRootIsDecorated(false);
+	m_resourceTypesList->setHeaderLabels(QStringList()
+											 << tr("Resource Type")
+											 << tr("Allowed")
+											 << tr("Blocked"));
+	m_resourceTypesList->header()->setSectionResizeMode(0, QHeaderView::Stretch);
+	m_resourceTypesList->header()->setStretchLastSection(false);
+
+	m_requestsLayout->addWidget(m_interceptorsList);
+	m_requestsLayout->addWidget(m_resourceTypesList);
+
+	m_pages->addTab(m_tabsList, tr("Tabs"));
+	m_pages->addTab(m_requestsPage, tr("Requests"));
+
+	m_exportButton = new QPushButton(tr("Export JSON..."), this);
+	m_closeButtonBox = new QDialogButtonBox(QDialogButtonBox::Close, Qt::Horizontal, this);
+
+	m_buttonsLayout->addWidget(m_exportButton);
+	m_buttonsLayout->addWidget(m_closeButtonBox);
+
+	m_layout->addWidget(m_pages);
+	m_layout->addLayout(m_buttonsLayout);
+}
+
+}
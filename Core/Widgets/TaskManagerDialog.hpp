@@ -0,0 +1,74 @@
+/***********************************************************************************
+** MIT License                                                                    **
+**                                                                                **
+** Copyright (c) 2018 Victor DENIS (victordenis01@gmail.com)                      **
+**                                                                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+***********************************************************************************/
+
+#pragma once
+#ifndef SIELO_BROWSER_TASKMANAGERDIALOG_HPP
+#define SIELO_BROWSER_TASKMANAGERDIALOG_HPP
+
+#include <QDialog>
+
+#include <QVBoxLayout>
+#include <QHBoxLayout>
+
+#include <QTabWidget>
+#include <QTreeWidget>
+#include <QPushButton>
+#include <QDialogButtonBox>
+
+#include <QTimer>
+
+namespace Sn {
+class TaskManagerDialog: public QDialog {
+Q_OBJECT
+
+public:
+	TaskManagerDialog(QWidget* parent = nullptr);
+	~TaskManagerDialog();
+
+private slots:
+	void refresh();
+	void refreshRequests();
+	void exportJson();
+
+private:
+	void setupUI();
+
+	QVBoxLayout* m_layout{nullptr};
+	QHBoxLayout* m_buttonsLayout{nullptr};
+
+	QTabWidget* m_pages{nullptr};
+	QTreeWidget* m_tabsList{nullptr};
+	QWidget* m_requestsPage{nullptr};
+	QVBoxLayout* m_requestsLayout{nullptr};
+	QTreeWidget* m_interceptorsList{nullptr};
+	QTreeWidget* m_resourceTypesList{nullptr};
+	QPushButton* m_exportButton{nullptr};
+	QDialogButtonBox* m_closeButtonBox{nullptr};
+
+	QTimer* m_refreshTimer{nullptr};
+};
+
+}
+
+#endif //SIELO_BROWSER_TASKMANAGERDIALOG_HPP
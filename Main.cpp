@@ -33,8 +33,12 @@
 
 #include "Core/BrowserWindow.hpp"
 
+#include "Core/Utils/StartupTracer.hpp"
+
 int main(int argc, char** argv)
 {
+	Sn::StartupTracer::start();
+
 	qputenv("QTWEBENGINE_REMOTE_DEBUGGING", "9000");
 	qputenv("QT_XCB_FORCE_SOFTWARE_OPENGL", "1");
 	qputenv("QT_AUTO_SCREEN_SCALE_FACTOR", "1");
@@ -29,17 +29,27 @@
 #include <QDir>
 #include <QFileInfo>
 #include <QFileInfoList>
+#include <QElapsedTimer>
 
 #include <iostream>
 
+#include "Utils/ThemeArchive.hpp"
+
 Application::Application(int& argc, char** argv) :
 	QApplication(argc, argv)
 {
 	if (argc > 1) {
 		QStringList args{QCoreApplication::arguments()};
 
-		if (args[1] == "compile") {
-			if (args[2] == "theme") {
+		parseOptions(args);
+
+		// Options are removed from the arguments, what's left may not be enough for any action
+		if (args.count() < 2 || args[1] == "-h" || args[1] == "--help")
+			printUsage();
+		else if (args[1] == "compile") {
+			if (args.count() < 5)
+				printUsage();
+			else if (args[2] == "theme") {
 				if (!compile(args[3], args[4] + QLatin1String(".snthm")))
 					QMessageBox::critical(nullptr,
 										  QApplication::tr("Error"),
@@ -55,7 +65,9 @@ Application::Application(int& argc, char** argv) :
 									  QApplication::tr("%1 is not a valid Sielo format").arg(args[2]));
 		}
 		else if (args[1] == "decompile") {
-			if (!decompile(args[2], args[3]))
+			if (args.count() < 4)
+				printUsage();
+			else if (!decompile(args[2], args[3]))
 				QMessageBox::critical(nullptr,
 									  QApplication::tr("Error"),
 									  QApplication::tr("Failed to decompile: ") + m_errors);
@@ -63,14 +75,6 @@ Application::Application(int& argc, char** argv) :
 				QMessageBox::information(nullptr, QApplication::tr("Success"), args[4]);
 			}
 		}
-		else if (args[1] == "-h" || args[1] == "--help") {
-			std::cout << QApplication::tr("Their is two ways to use this command:").toStdString() << std::endl << std::endl;
-			std::cout << QApplication::tr("$ sielo-compiler compile theme (path to the theme folder) (name of the theme)").toStdString() << std::endl;
-			std::cout << " -> " << QApplication::tr("This will compile your theme in a basic \".sntm\" file. The output is in the theme folder directory.").toStdString() << std::endl << std::endl;
-			std::cout << QApplication::tr("$ sielo-compiler decompile (path to the theme file) (path where the theme must be decompiled)").toStdString() << std::endl;
-			std::cout << " -> " << QApplication::tr("This will decompile your theme in the directory you choose.").toStdString() << std::endl << std::endl;
-
-		}
 		else
 			QMessageBox::critical(nullptr,
 								  QApplication::tr("Error"),
@@ -94,20 +98,30 @@ bool Application::compile(const QString& srcFolder, const QString& fileDestinati
 		return false;
 	}
 
-	m_file.setFileName(fileDestination);
+	QElapsedTimer timer{};
+	timer.start();
+
+	m_files.clear();
 
-	if (!m_file.open(QIODevice::WriteOnly)) {
-		m_errors = QApplication::tr("The destination file can't be open.");
+	if (!compress(srcFolder, ""))
 		return false;
-	}
 
-	m_stream.setDevice(&m_file);
+	Sn::ThemeArchive::WriteStats stats{};
 
-	bool success{compress(srcFolder, "")};
+	if (!Sn::ThemeArchive::write(fileDestination, m_files, m_compressionLevel, &m_errors, &stats))
+		return false;
 
-	m_file.close();
+	if (m_showStats) {
+		std::cout << QApplication::tr("Files: %1 (%2 unique)").arg(stats.files).arg(stats.uniqueFiles).toStdString()
+				  << std::endl;
+		std::cout << QApplication::tr("Size: %1 bytes -> %2 bytes (%3%)")
+			.arg(stats.inputSize)
+			.arg(stats.outputSize)
+			.arg(stats.inputSize > 0 ? 100 * stats.outputSize / stats.inputSize : 100).toStdString() << std::endl;
+		std::cout << QApplication::tr("Time: %1 ms").arg(timer.elapsed()).toStdString() << std::endl;
+	}
 
-	return success;
+	return true;
 
 }
 
@@ -128,47 +142,76 @@ bool Application::decompile(const QString& srcFile, const QString& filesDestinat
 		return false;
 	}
 
-	if (!src.open(QIODevice::ReadOnly)) {
+	// Both indexed (v2) and sequential (v1) archives are supported
+	Sn::ThemeArchive archive{srcFile};
+
+	if (!archive.isValid()) {
 		m_errors = QApplication::tr("Failed to read compiled file.");
 		return false;
 	}
 
-	QDataStream stream{&src};
-
-	while (!stream.atEnd()) {
-		QString fileName{};
-		QByteArray data{};
-
-		stream >> fileName >> data;
-
-		QString subFolder{};
-
-		for (int i{fileName.length() - 1}; i > 0; --i) {
-			if ((QString(fileName[i]) == QString("\\")) || (QString(fileName[i]) == QString("/"))) {
-				subFolder = fileName.left(i);
-				dir.mkpath(filesDestination + QLatin1Char('/') + subFolder);
-
-				break;
-			}
-		}
+	foreach (const QString& fileName, archive.entries()) {
+		name.setFile(filesDestination + QLatin1Char('/') + fileName);
+		dir.mkpath(name.absolutePath());
 
-		QFile outFile{filesDestination + QLatin1Char('/') + fileName};
+		QFile outFile{name.absoluteFilePath()};
 
 		if (!outFile.open(QIODevice::WriteOnly)) {
-			src.close();
 			m_errors = QApplication::tr("Failed to write decompiled files.");
 			return false;
 		}
 
-		outFile.write(qUncompress(data));
+		outFile.write(archive.read(fileName));
 		outFile.close();
 	}
 
-	src.close();
-
 	return true;
 }
 
+void Application::parseOptions(QStringList& args)
+{
+	for (int i{args.count() - 1}; i > 0; --i) {
+		QString level{};
+
+		if (args[i] == QLatin1String("--stats")) {
+			m_showStats = true;
+			args.removeAt(i);
+			continue;
+		}
+
+		if (args[i] == QLatin1String("--level") && i + 1 < args.count()) {
+			level = args.takeAt(i + 1);
+			args.removeAt(i);
+		}
+		else if (args[i].startsWith(QLatin1String("--level="))) {
+			level = args.takeAt(i).mid(8);
+		}
+		else {
+			continue;
+		}
+
+		bool ok{false};
+		const int compressionLevel{level.toInt(&ok)};
+
+		if (ok)
+			m_compressionLevel = qBound(-1, compressionLevel, 9);
+		else
+			std::cout << QApplication::tr("Invalid compression level: %1").arg(level).toStdString() << std::endl;
+	}
+}
+
+void Application::printUsage() const
+{
+	std::cout << QApplication::tr("Their is two ways to use this command:").toStdString() << std::endl << std::endl;
+	std::cout << QApplication::tr("$ sielo-compiler compile theme (path to the theme folder) (name of the theme)").toStdString() << std::endl;
+	std::cout << " -> " << QApplication::tr("This will compile your theme in a basic \".sntm\" file. The output is in the theme folder directory.").toStdString() << std::endl << std::endl;
+	std::cout << QApplication::tr("$ sielo-compiler decompile (path to the theme file) (path where the theme must be decompiled)").toStdString() << std::endl;
+	std::cout << " -> " << QApplication::tr("This will decompile your theme in the directory you choose.").toStdString() << std::endl << std::endl;
+	std::cout << QApplication::tr("Options for compile:").toStdString() << std::endl;
+	std::cout << "  --level (0-9)  " << QApplication::tr("Compression level, 9 is the smallest and slowest.").toStdString() << std::endl;
+	std::cout << "  --stats        " << QApplication::tr("Print files, deduplication and size statistics.").toStdString() << std::endl << std::endl;
+}
+
 bool Application::compress(const QString& srcFolder, const QString& prefexe)
 {
 	QDir dir{srcFolder};
@@ -197,8 +240,7 @@ bool Application::compress(const QString& srcFolder, const QString& prefexe)
 			return false;
 		}
 
-		m_stream << QString(prefexe + QLatin1Char('/') + filesList[i].fileName());
-		m_stream << qCompress(file.readAll());
+		m_files.append(qMakePair(QString(prefexe + QLatin1Char('/') + filesList[i].fileName()), file.readAll()));
 
 		file.close();
 	}
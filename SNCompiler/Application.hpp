@@ -28,8 +28,8 @@
 
 #include <QApplication>
 
-#include <QFile>
-#include <QDataStream>
+#include <QVector>
+#include <QPair>
 
 class Application: public QApplication {
 public:
@@ -41,10 +41,14 @@ private:
 	bool decompile(const QString& srcFile, const QString& filesDestination);
 
 	bool compress(const QString& srcFolder, const QString& prefexe);
+	void parseOptions(QStringList& args);
+	void printUsage() const;
 
 	QString m_errors{};
 
-	QFile m_file{};
-	QDataStream m_stream{};
+	int m_compressionLevel{-1};
+	bool m_showStats{false};
+
+	QVector<QPair<QString, QByteArray>> m_files{};
 };
 #endif //SIELO_BROWSER_APPLICATION_HPP
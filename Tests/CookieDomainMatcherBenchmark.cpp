@@ -0,0 +1,161 @@
+/***********************************************************************************
+** MIT License                                                                    **
+**                                                                                **
+** Copyright (c) 2018 Victor DENIS (victordenis01@gmail.com)                      **
+**                                                                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+***********************************************************************************/
+
+#include <QtTest>
+
+#include "Cookies/CookieDomainMatcher.hpp"
+
+namespace Sn {
+
+/*
+ * Compares the domain trie used by CookieJar with the linear endsWith/indexOf
+ * scan it replaced, for white/black lists of a few thousand entries.
+ */
+class CookieDomainMatcherBenchmark: public QObject {
+Q_OBJECT
+
+private slots:
+	void initTestCase();
+
+	void matches_data();
+	void matches();
+
+	void listMatchesDomain_data();
+	void listMatchesDomain();
+
+private:
+	static bool matchDomain(QString cookieDomain, QString siteDomain);
+	static bool listMatchesDomain(const QStringList& list, const QString& cookieDomain);
+
+	void addRows();
+
+	QStringList m_list{};
+	QStringList m_cookieDomains{};
+};
+
+void CookieDomainMatcherBenchmark::initTestCase()
+{
+	static const QStringList tlds{"com", "net", "org", "fr", "co.uk", "de"};
+
+	for (int i{0}; i < 5000; ++i)
+		m_list.append(QString("site%1.%2").arg(i).arg(tlds[i % tlds.size()]));
+
+	for (int i{0}; i < 1000; ++i) {
+		if (i % 4 == 0)
+			m_cookieDomains.append(QString(".www.site%1.%2").arg(i * 5).arg(tlds[(i * 5) % tlds.size()]));
+		else
+			m_cookieDomains.append(QString(".cdn%1.tracker.example").arg(i));
+	}
+
+	// Both implementations must agree before comparing them
+	CookieDomainMatcher matcher{};
+	matcher.compile(m_list);
+
+	foreach (const QString& domain, m_cookieDomains)
+		QCOMPARE(matcher.matches(domain), listMatchesDomain(m_list, domain));
+}
+
+void CookieDomainMatcherBenchmark::matches_data()
+{
+	addRows();
+}
+
+void CookieDomainMatcherBenchmark::matches()
+{
+	QFETCH(int, entries);
+
+	CookieDomainMatcher matcher{};
+	matcher.compile(m_list.mid(0, entries));
+
+	int matched{0};
+
+	QBENCHMARK {
+		foreach (const QString& domain, m_cookieDomains)
+			matched += matcher.matches(domain) ? 1 : 0;
+	}
+
+	QVERIFY(matched > 0);
+}
+
+void CookieDomainMatcherBenchmark::listMatchesDomain_data()
+{
+	addRows();
+}
+
+void CookieDomainMatcherBenchmark::listMatchesDomain()
+{
+	QFETCH(int, entries);
+
+	const QStringList list{m_list.mid(0, entries)};
+	int matched{0};
+
+	QBENCHMARK {
+		foreach (const QString& domain, m_cookieDomains)
+			matched += listMatchesDomain(list, domain) ? 1 : 0;
+	}
+
+	QVERIFY(matched > 0);
+}
+
+bool CookieDomainMatcherBenchmark::matchDomain(QString cookieDomain, QString siteDomain)
+{
+	if (cookieDomain.startsWith(QLatin1Char('.')))
+		cookieDomain = cookieDomain.mid(1);
+
+	if (siteDomain.startsWith(QLatin1Char('.')))
+		siteDomain = siteDomain.mid(1);
+
+	if (cookieDomain == siteDomain)
+		return true;
+
+	if (!siteDomain.endsWith(cookieDomain))
+		return false;
+
+	return siteDomain.indexOf(cookieDomain) > 0 && siteDomain[siteDomain.indexOf(cookieDomain) - 1] == QLatin1Char('.');
+}
+
+bool CookieDomainMatcherBenchmark::listMatchesDomain(const QStringList& list, const QString& cookieDomain)
+{
+	foreach (const QString& domain, list) {
+		if (matchDomain(domain, cookieDomain))
+			return true;
+	}
+
+	return false;
+}
+
+void CookieDomainMatcherBenchmark::addRows()
+{
+	QTest::addColumn<int>("entries");
+
+	QTest::newRow("100 entries") << 100;
+	QTest::newRow("1000 entries") << 1000;
+	QTest::newRow("5000 entries") << 5000;
+}
+
+}
+
+QTEST_APPLESS_MAIN(Sn::CookieDomainMatcherBenchmark)
+
+#include "CookieDomainMatcherBenchmark.moc"
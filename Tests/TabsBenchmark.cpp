@@ -0,0 +1,367 @@
+/***********************************************************************************
+** MIT License                                                                    **
+**                                                                                **
+** Copyright (c) 2018 Victor DENIS (victordenis01@gmail.com)                      **
+**                                                                                **
+** Permission is hereby granted, free of charge, to any person obtaining a copy   **
+** of this software and associated documentation files (the "Software"), to deal  **
+** in the Software without restriction, including without limitation the rights   **
+** to use, copy, modify, merge, publish, distribute, sublicense, and/or sell      **
+** copies of the Software, and to permit persons to whom the Software is          **
+** furnished to do so, subject to the following conditions:                       **
+**                                                                                **
+** The above copyright notice and this permission notice shall be included in all **
+** copies or substantial portions of the Software.                                **
+**                                                                                **
+** THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR     **
+** IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,       **
+** FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE    **
+** AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER         **
+** LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,  **
+** OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE  **
+** SOFTWARE.                                                                      **
+***********************************************************************************/
+
+#include <QtTest>
+
+#include "Application.hpp"
+#include "BrowserWindow.hpp"
+
+#include "Utils/RestoreManager.hpp"
+
+#include "Web/LoadRequest.hpp"
+#include "Web/Tab/WebTab.hpp"
+#include "Web/Tab/TabsLifecycleManager.hpp"
+
+#include "Widgets/Tab/TabWidget.hpp"
+#include "Widgets/Tab/MainTabBar.hpp"
+
+namespace Sn {
+
+/*
+ * Measure open, switch, pin, move, session save/restore and close throughput of the tabs machinery.
+ * Every operation runs on a fresh window, set QT_QPA_PLATFORM=offscreen for headless runs.
+ */
+class TabsBenchmark: public QObject {
+Q_OBJECT
+
+private slots:
+	void initTestCase();
+	void cleanup();
+
+	void open_data();
+	void open();
+
+	void switchTabs_data();
+	void switchTabs();
+
+	void pin_data();
+	void pin();
+
+	void unpin_data();
+	void unpin();
+
+	void move_data();
+	void move();
+
+	void sessionSave_data();
+	void sessionSave();
+
+	void sessionDecode_data();
+	void sessionDecode();
+
+	void sessionRestore_data();
+	void sessionRestore();
+
+	void close_data();
+	void close();
+
+private:
+	void addRows();
+
+	TabWidget* createWindow();
+	void openTabs(TabWidget* tabWidget, int tabsCount);
+
+	static void processEvents();
+	static QUrl pageUrl(int index);
+
+	BrowserWindow* m_window{nullptr};
+	int m_firstTab{0};
+};
+
+void TabsBenchmark::initTestCase()
+{
+	// Discarding or freezing tabs in the middle of a measure would skew it
+	Application::instance()->tabsLifecycleManager()->setSuspended(true);
+}
+
+void TabsBenchmark::cleanup()
+{
+	if (m_window)
+		m_window->close();
+
+	m_window = nullptr;
+	processEvents();
+}
+
+void TabsBenchmark::open_data()
+{
+	addRows();
+}
+
+void TabsBenchmark::open()
+{
+	QFETCH(int, tabsCount);
+
+	TabWidget* tabWidget{createWindow()};
+
+	QBENCHMARK_ONCE {
+		openTabs(tabWidget, tabsCount);
+	}
+
+	QCOMPARE(tabWidget->count(), m_firstTab + tabsCount);
+}
+
+void TabsBenchmark::switchTabs_data()
+{
+	addRows();
+}
+
+void TabsBenchmark::switchTabs()
+{
+	QFETCH(int, tabsCount);
+
+	TabWidget* tabWidget{createWindow()};
+	openTabs(tabWidget, tabsCount);
+
+	QBENCHMARK_ONCE {
+		for (int i{m_firstTab}; i < tabWidget->count(); ++i)
+			tabWidget->setCurrentIndex(i);
+		processEvents();
+	}
+
+	QCOMPARE(tabWidget->currentIndex(), tabWidget->count() - 1);
+}
+
+void TabsBenchmark::pin_data()
+{
+	addRows();
+}
+
+void TabsBenchmark::pin()
+{
+	QFETCH(int, tabsCount);
+
+	TabWidget* tabWidget{createWindow()};
+	openTabs(tabWidget, tabsCount);
+
+	// Pinning moves a tab in front of the unpinned ones, which only shifts the tabs before it,
+	// so the tabs still to pin keep their index
+	QBENCHMARK_ONCE {
+		for (int i{m_firstTab}; i < m_firstTab + tabsCount; ++i)
+			tabWidget->weTab(i)->togglePinned();
+		processEvents();
+	}
+
+	QCOMPARE(tabWidget->pinnedTabsCount(), tabsCount);
+}
+
+void TabsBenchmark::unpin_data()
+{
+	addRows();
+}
+
+void TabsBenchmark::unpin()
+{
+	QFETCH(int, tabsCount);
+
+	TabWidget* tabWidget{createWindow()};
+	openTabs(tabWidget, tabsCount);
+
+	for (int i{m_firstTab}; i < m_firstTab + tabsCount; ++i)
+		tabWidget->weTab(i)->togglePinned();
+	processEvents();
+
+	// An unpinned tab leaves the pinned area, so the next one to unpin is always the first tab
+	QBENCHMARK_ONCE {
+		for (int i{0}; i < tabsCount; ++i)
+			tabWidget->weTab(0)->togglePinned();
+		processEvents();
+	}
+
+	QCOMPARE(tabWidget->pinnedTabsCount(), 0);
+}
+
+void TabsBenchmark::move_data()
+{
+	addRows();
+}
+
+void TabsBenchmark::move()
+{
+	QFETCH(int, tabsCount);
+
+	TabWidget* tabWidget{createWindow()};
+	openTabs(tabWidget, tabsCount);
+
+	QBENCHMARK_ONCE {
+		for (int i{0}; i < tabsCount; ++i)
+			tabWidget->tabBar()->moveTab(m_firstTab, tabWidget->count() - 1);
+		processEvents();
+	}
+
+	QCOMPARE(tabWidget->count(), m_firstTab + tabsCount);
+}
+
+void TabsBenchmark::sessionSave_data()
+{
+	addRows();
+}
+
+void TabsBenchmark::sessionSave()
+{
+	QFETCH(int, tabsCount);
+
+	openTabs(createWindow(), tabsCount);
+
+	QByteArray sessionData{};
+
+	QBENCHMARK_ONCE {
+		sessionData = RestoreManager::serialize(QList<BrowserWindow*>() << m_window);
+	}
+
+	QVERIFY(!sessionData.isEmpty());
+}
+
+void TabsBenchmark::sessionDecode_data()
+{
+	addRows();
+}
+
+void TabsBenchmark::sessionDecode()
+{
+	QFETCH(int, tabsCount);
+
+	openTabs(createWindow(), tabsCount);
+
+	const QByteArray sessionData{RestoreManager::serialize(QList<BrowserWindow*>() << m_window)};
+	bool valid{false};
+
+	QBENCHMARK_ONCE {
+		RestoreManager restoreManager{sessionData};
+		valid = restoreManager.isValid();
+	}
+
+	QVERIFY(valid);
+}
+
+void TabsBenchmark::sessionRestore_data()
+{
+	addRows();
+}
+
+void TabsBenchmark::sessionRestore()
+{
+	QFETCH(int, tabsCount);
+
+	openTabs(createWindow(), tabsCount);
+
+	RestoreManager restoreManager{RestoreManager::serialize(QList<BrowserWindow*>() << m_window)};
+	QVERIFY(restoreManager.isValid());
+
+	BrowserWindow* restoredWindow{Application::instance()->createWindow(Application::WT_OtherRestoredWindow)};
+	processEvents();
+
+	QBENCHMARK_ONCE {
+		restoredWindow->restoreWindowState(restoreManager.restoreData()[0]);
+		processEvents();
+	}
+
+	QVERIFY(restoredWindow->tabWidget()->count() >= tabsCount);
+
+	restoredWindow->close();
+}
+
+void TabsBenchmark::close_data()
+{
+	addRows();
+}
+
+void TabsBenchmark::close()
+{
+	QFETCH(int, tabsCount);
+
+	TabWidget* tabWidget{createWindow()};
+	openTabs(tabWidget, tabsCount);
+
+	QBENCHMARK_ONCE {
+		while (tabWidget->count() > m_firstTab)
+			tabWidget->closeTab(tabWidget->count() - 1);
+		processEvents();
+	}
+
+	QCOMPARE(tabWidget->count(), m_firstTab);
+}
+
+void TabsBenchmark::addRows()
+{
+	QTest::addColumn<int>("tabsCount");
+
+	QTest::newRow("10 tabs") << 10;
+	QTest::newRow("100 tabs") << 100;
+	QTest::newRow("1000 tabs") << 1000;
+}
+
+TabWidget* TabsBenchmark::createWindow()
+{
+	m_window = Application::instance()->createWindow(Application::WT_NewWindow);
+	processEvents();
+
+	// The window opens with its own tab, benchmarked tabs start after it
+	m_firstTab = m_window->tabWidget()->count();
+
+	return m_window->tabWidget();
+}
+
+void TabsBenchmark::openTabs(TabWidget* tabWidget, int tabsCount)
+{
+	for (int i{0}; i < tabsCount; ++i)
+		tabWidget->addView(LoadRequest(pageUrl(i)), Application::NTT_NotSelectedTabAtEnd);
+	processEvents();
+}
+
+void TabsBenchmark::processEvents()
+{
+	QCoreApplication::processEvents(QEventLoop::AllEvents);
+	QCoreApplication::sendPostedEvents(nullptr, QEvent::DeferredDelete);
+}
+
+QUrl TabsBenchmark::pageUrl(int index)
+{
+	return QUrl(QString("data:text/html,<title>Tab %1</title><p>Tab %1</p>").arg(index));
+}
+}
+
+int main(int argc, char** argv)
+{
+	// The browser runs as its own private instance, user's data are never touched. Its arguments are
+	// kept apart from the test ones, which QTest parses.
+	char privateBrowsing[] = "--private-browsing";
+	char newInstance[] = "--no-remote";
+	char* applicationArgv[] = {argv[0], privateBrowsing, newInstance, nullptr};
+	int applicationArgc{3};
+
+	Sn::Application app(applicationArgc, applicationArgv);
+
+	if (app.isClosing())
+		return 1;
+
+	Sn::TabsBenchmark benchmark{};
+	const int result{QTest::qExec(&benchmark, argc, argv)};
+
+	app.quitApplication();
+
+	return result;
+}
+
+#include "TabsBenchmark.moc"